@@ -0,0 +1,82 @@
+#include "BallComponent.h"
+#include "Game.h"
+#include <cmath>
+
+using namespace DirectX::SimpleMath;
+
+BallComponent::BallComponent(TransformSystem* transforms, TransformId transform, const DirectX::BoundingBox& bounds,
+	TransformId leftRacket, const DirectX::BoundingBox& leftBounds,
+	TransformId rightRacket, const DirectX::BoundingBox& rightBounds,
+	const Vector2& velocity) {
+	this->transforms = transforms;
+	this->transform = transform;
+	this->bounds = bounds;
+	this->leftRacket = leftRacket;
+	this->rightRacket = rightRacket;
+	this->velocity = velocity;
+
+	racketBounds[0] = leftBounds;
+	racketBounds[1] = rightBounds;
+}
+
+/*
+* Overlap of the ball at "position" with the racket rectangle in the XY plane
+*/
+bool BallComponent::Hits(const Vector3& position, TransformId racket, const DirectX::BoundingBox& racketBounds) {
+	Vector3 racketPosition = transforms->GetPosition(racket);
+
+	float dx = fabsf(position.x + bounds.Center.x - racketPosition.x - racketBounds.Center.x);
+	float dy = fabsf(position.y + bounds.Center.y - racketPosition.y - racketBounds.Center.y);
+
+	return dx <= bounds.Extents.x + racketBounds.Extents.x && dy <= bounds.Extents.y + racketBounds.Extents.y;
+}
+
+void BallComponent::Initialize() {
+
+}
+
+void BallComponent::Update() {
+
+}
+
+/*
+* One step with "fixedDeltaTime", so the ball path doesn't depend on the frame rate
+* A bounce only flips the velocity towards the field, so the ball can't get stuck inside a racket
+*/
+void BallComponent::FixedUpdate() {
+	float deltaTime = Game::instance->fixedDeltaTime;
+
+	Vector3 position = transforms->GetPosition(transform);
+	position.x += velocity.x * deltaTime;
+	position.y += velocity.y * deltaTime;
+
+	float top = position.y + bounds.Center.y + bounds.Extents.y;
+	float bottom = position.y + bounds.Center.y - bounds.Extents.y;
+	if ((top > 1.0f && velocity.y > 0) || (bottom < -1.0f && velocity.y < 0))
+		velocity.y = -velocity.y;
+
+	if (velocity.x < 0 && Hits(position, leftRacket, racketBounds[0]))
+		velocity.x = -velocity.x;
+	if (velocity.x > 0 && Hits(position, rightRacket, racketBounds[1]))
+		velocity.x = -velocity.x;
+
+	// Missed: serve from the center towards the player who scored (away from the side the ball left through)
+	if (fabsf(position.x) > 1.0f + bounds.Extents.x * 2.0f) {
+		position = Vector3::Zero;
+		velocity.x = -velocity.x;
+	}
+
+	transforms->SetPosition(transform, position);
+}
+
+void BallComponent::Draw() {
+
+}
+
+void BallComponent::Reload() {
+
+}
+
+void BallComponent::DestroyResources() {
+
+}
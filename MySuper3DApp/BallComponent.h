@@ -0,0 +1,35 @@
+#pragma once
+#include "GameObjectComponent.h"
+#include "TransformSystem.h"
+
+/*
+* Physics of the ping pong ball
+* Moves with a constant speed, bounces off the top and bottom edges of the field and off the rackets,
+* is served again from the center after it leaves the field on the left or the right
+* Boxes are local rectangles of the meshes, rackets are only translated
+*/
+class BallComponent : public GameObjectComponent {
+protected:
+	TransformSystem* transforms;
+	TransformId transform; // Of the ball
+	TransformId leftRacket;
+	TransformId rightRacket;
+	DirectX::BoundingBox bounds; // Of the ball
+	DirectX::BoundingBox racketBounds[2]; // Left and right
+	DirectX::SimpleMath::Vector2 velocity; // Field units per second
+
+	bool Hits(const DirectX::SimpleMath::Vector3& position, TransformId racket, const DirectX::BoundingBox& racketBounds);
+
+public:
+	BallComponent(TransformSystem* transforms, TransformId transform, const DirectX::BoundingBox& bounds,
+		TransformId leftRacket, const DirectX::BoundingBox& leftBounds,
+		TransformId rightRacket, const DirectX::BoundingBox& rightBounds,
+		const DirectX::SimpleMath::Vector2& velocity);
+
+	void Initialize();
+	void Update();
+	void FixedUpdate();
+	void Draw();
+	void Reload();
+	void DestroyResources();
+};
@@ -0,0 +1,928 @@
+#include "Benchmarks.h"
+#include "PingPongGame.h"
+#include "JobSystem.h"
+#include "EntityWorld.h"
+#include "EntitySystemComponent.h"
+#include "FrameArena.h"
+#include "SpriteBatcher.h"
+#include "RenderCommandBuffer.h"
+#include "SoftwareRasterizer.h"
+#include "UploadRing.h"
+#include "VertexLayout.h"
+#include "FrustumCuller.h"
+#include "ConcurrentDelegates.h"
+#include "EventBus.h"
+#include <random>
+#include <algorithm>
+#include <cstring>
+
+/*
+* Concurrent component with some math in Update()
+* Stands for a typical gameplay component in scaling benchmarks
+*/
+class SpinComponent : public GameObjectComponent {
+public:
+	float value = 1.0f;
+
+	void Initialize() {}
+	void Update() {
+		for (int i = 0; i < 200; i++)
+			value = value * 0.999f + 0.001f;
+	}
+	void FixedUpdate() {}
+	void Draw() {}
+	void Reload() {}
+	void DestroyResources() {}
+	bool IsConcurrent() { return true; }
+};
+
+struct BenchmarkPosition {
+	float x, y, z;
+};
+
+struct BenchmarkVelocity {
+	float x, y, z;
+};
+
+/*
+* The same movement as an entity system, but as a heap allocated polymorphic component
+*/
+class MoveComponent : public GameObjectComponent {
+public:
+	BenchmarkPosition position = { 0, 0, 0 };
+	BenchmarkVelocity velocity = { 1, 2, 3 };
+
+	void Initialize() {}
+	void Update() {
+		position.x += velocity.x * 0.016f;
+		position.y += velocity.y * 0.016f;
+		position.z += velocity.z * 0.016f;
+	}
+	void FixedUpdate() {}
+	void Draw() {}
+	void Reload() {}
+	void DestroyResources() {}
+};
+
+/*
+* Free function bound by the delegate benchmarks
+*/
+static int BenchmarkAdd(int value, int payload) {
+	return value + payload;
+}
+
+/*
+* Bind, copy and execute cost of one callable type in "DelegateT" (Delegate or std::function)
+*/
+template<typename DelegateT, typename MakeDelegate>
+static void MeasureDelegate(const char* name, MakeDelegate makeDelegate) {
+	const int iterations = 1000000;
+	volatile unsigned int sink = 0; // Unsigned, so the sum wraps instead of overflowing
+
+	auto startTime = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++) {
+		DelegateT bound = makeDelegate(i);
+		sink = sink + bound(i);
+	}
+	auto copyStart = std::chrono::steady_clock::now();
+
+	DelegateT original = makeDelegate(1);
+	for (int i = 0; i < iterations; i++) {
+		DelegateT copy = original;
+		sink = sink + copy(i);
+	}
+	auto executeStart = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < iterations; i++)
+		sink = sink + original(i);
+	auto endTime = std::chrono::steady_clock::now();
+
+	float bindTime = std::chrono::duration<float>(copyStart - startTime).count() / iterations;
+	float copyTime = std::chrono::duration<float>(executeStart - copyStart).count() / iterations;
+	float executeTime = std::chrono::duration<float>(endTime - executeStart).count() / iterations;
+
+	std::cout << "delegate-binding: " << name
+		<< ", bind+execute " << bindTime * 1000000000.0f << " ns"
+		<< ", copy+execute " << copyTime * 1000000000.0f << " ns"
+		<< ", execute " << executeTime * 1000000000.0f << " ns" << std::endl;
+}
+
+/*
+* Member function target of the delegate benchmarks
+*/
+struct BenchmarkCounter {
+	unsigned int value = 0; // Unsigned, so the sum wraps instead of overflowing
+
+	int Add(int amount) {
+		value += static_cast<unsigned int>(amount);
+		return static_cast<int>(value);
+	}
+};
+
+/*
+* Time of "calls" calls of "call(i)" in ns per call
+*/
+template<typename Call>
+static float MeasureCalls(int calls, Call call) {
+	volatile unsigned int sink = 0;
+
+	auto startTime = std::chrono::steady_clock::now();
+	for (int i = 0; i < calls; i++)
+		sink = sink + call(i);
+	float time = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+
+	return time / calls * 1000000000.0f;
+}
+
+/*
+* Run benchmark by its name
+* Returns false if there is no such benchmark
+*/
+bool Benchmarks::Run(const std::string& name) {
+	if (name == "fixed-tick")
+		FixedTick();
+	else if (name == "headless-frames")
+		HeadlessFrames();
+	else if (name == "job-scaling")
+		JobScaling();
+	else if (name == "entity-iteration")
+		EntityIteration();
+	else if (name == "frame-allocation")
+		FrameAllocation();
+	else if (name == "sprite-batching")
+		SpriteBatching();
+	else if (name == "command-sort")
+		CommandSort();
+	else if (name == "software-raster")
+		SoftwareRaster();
+	else if (name == "upload-ring")
+		UploadRing();
+	else if (name == "vertex-packing")
+		VertexPacking();
+	else if (name == "frustum-culling")
+		FrustumCulling();
+	else if (name == "delegate-contention")
+		DelegateContention();
+	else if (name == "delegate-churn")
+		DelegateChurn();
+	else if (name == "event-coalescing")
+		EventCoalescing();
+	else if (name == "delegate-binding")
+		DelegateBinding();
+	else if (name == "delegate-invocation")
+		DelegateInvocation();
+	else {
+		std::cout << "Unknown benchmark: " << name << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/*
+* Simulation cost of the fixed tick of PingPongGame apart from rendering
+* Ball physics of 1000 balls against the rackets, transform update and saving for interpolation
+* 1 second frames force the scheduler to catch up on every frame
+*/
+void Benchmarks::FixedTick() {
+	const size_t ballCount = 1000;
+	const unsigned int frames = 5000;
+
+	PingPongGame::CreateInstance(L"Ping Pong", 1280, 720, true);
+	PingPongGame* game = static_cast<PingPongGame*>(PingPongGame::instance);
+	game->ConfigureGameObjects();
+	game->SpawnBalls(ballCount - 1);
+
+	for (float frameDeltaTime : { 1.0f / 60.0f, 1.0f / 15.0f, 1.0f }) {
+		FixedTimestep::BenchmarkResult result = Game::instance->BenchmarkFixedUpdate(frames, frameDeltaTime);
+
+		std::cout << "fixed-tick: balls " << ballCount
+			<< ", frame " << frameDeltaTime * 1000.0f << " ms"
+			<< ", ticks " << result.ticks
+			<< ", ticks/s " << result.ticksPerSecond
+			<< ", tick " << (result.ticksPerSecond > 0 ? 1000000.0f / result.ticksPerSecond : 0) << " us"
+			<< ", worst catch-up " << result.worstCatchUpTime * 1000000.0f << " us"
+			<< " (" << result.worstCatchUpSteps << " ticks)" << std::endl;
+	}
+}
+
+/*
+* CPU side of the whole frame loop of PingPongGame
+* Null window and graphics backends, so no window and no GPU are needed
+*/
+void Benchmarks::HeadlessFrames() {
+	const unsigned int frames = 100000;
+
+	PingPongGame::CreateInstance(L"Ping Pong", 1280, 720, true);
+	Game::instance->SetHeadless(frames);
+
+	auto startTime = std::chrono::steady_clock::now();
+	Game::instance->Run();
+	float totalTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+
+	std::cout << "headless-frames: frames " << frames
+		<< ", total " << totalTime << " s"
+		<< ", frame " << totalTime / frames * 1000000.0f << " us"
+		<< ", frames/s " << frames / totalTime << std::endl;
+}
+
+/*
+* Speedup of the concurrent update of game objects on 1/2/4/8/N threads
+*/
+void Benchmarks::JobScaling() {
+	const size_t objectCount = 50000;
+	const int iterations = 50;
+
+	std::vector<std::unique_ptr<GameObject>> objects;
+	std::vector<std::unique_ptr<SpinComponent>> components;
+	for (size_t i = 0; i < objectCount; i++) {
+		objects.push_back(std::make_unique<GameObject>());
+		components.push_back(std::make_unique<SpinComponent>());
+		objects.back()->components.push_back(components.back().get());
+	}
+
+	unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<unsigned int> threadCounts = { 1, 2, 4, 8 };
+	if (std::find(threadCounts.begin(), threadCounts.end(), hardwareThreads) == threadCounts.end())
+		threadCounts.push_back(hardwareThreads);
+
+	float singleThreadTime = 0;
+	for (unsigned int threads : threadCounts) {
+		JobSystem jobSystem(threads);
+
+		auto startTime = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++) {
+			jobSystem.ParallelFor(objects.size(), 256, [&objects](size_t begin, size_t end) {
+				for (size_t j = begin; j < end; j++)
+					objects[j]->UpdateConcurrent();
+			});
+		}
+		float time = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count() / iterations;
+
+		if (threads == 1)
+			singleThreadTime = time;
+
+		std::cout << "job-scaling: threads " << threads
+			<< ", update " << time * 1000.0f << " ms"
+			<< ", speedup " << singleThreadTime / time << std::endl;
+	}
+}
+
+/*
+* 100k moving objects: GameObject with a virtual component vs entities in archetype chunks
+*/
+void Benchmarks::EntityIteration() {
+	const size_t objectCount = 100000;
+	const int iterations = 100;
+
+	std::vector<std::unique_ptr<GameObject>> objects;
+	for (size_t i = 0; i < objectCount; i++) {
+		objects.push_back(std::make_unique<GameObject>());
+		objects.back()->components.push_back(new MoveComponent());
+	}
+
+	auto startTime = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++)
+		for (auto& object : objects)
+			object->Update();
+	float objectTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count() / iterations;
+
+	for (auto& object : objects)
+		for (auto component : object->components)
+			delete component;
+
+	EntityWorld world;
+	for (size_t i = 0; i < objectCount; i++)
+		world.Create(BenchmarkPosition{ 0, 0, 0 }, BenchmarkVelocity{ 1, 2, 3 });
+
+	// Runs through the adapter, like a system in a real scene
+	EntitySystemComponent moveSystem(&world, [](EntityWorld& world) {
+		world.EachChunk<BenchmarkPosition, BenchmarkVelocity>([](size_t count, BenchmarkPosition* positions, BenchmarkVelocity* velocities) {
+			for (size_t i = 0; i < count; i++) {
+				positions[i].x += velocities[i].x * 0.016f;
+				positions[i].y += velocities[i].y * 0.016f;
+				positions[i].z += velocities[i].z * 0.016f;
+			}
+		});
+	});
+
+	startTime = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++)
+		moveSystem.Update();
+	float entityTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count() / iterations;
+
+	// Read position and velocity, write position
+	float bytes = static_cast<float>(objectCount * (2 * sizeof(BenchmarkPosition) + sizeof(BenchmarkVelocity)));
+
+	std::cout << "entity-iteration: game objects " << objectTime * 1000000000.0f / objectCount << " ns/object"
+		<< ", entities " << entityTime * 1000000000.0f / objectCount << " ns/entity"
+		<< " (" << bytes / entityTime / 1000000000.0f << " GB/s)"
+		<< ", speedup " << objectTime / entityTime << std::endl;
+}
+
+/*
+* Transient allocations of one frame: malloc/free pairs vs frame arena bumps
+* Sizes are like WM_INPUT buffers and small descriptors
+*/
+void Benchmarks::FrameAllocation() {
+	const int frames = 1000;
+	const int allocationsPerFrame = 1000;
+	const size_t sizes[] = { 16, 48, 64, 128 };
+
+	volatile unsigned char sink = 0;
+
+	auto startTime = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frames; frame++) {
+		for (int i = 0; i < allocationsPerFrame; i++) {
+			unsigned char* data = static_cast<unsigned char*>(malloc(sizes[i % 4]));
+			data[0] = static_cast<unsigned char>(i);
+			sink = sink + data[0];
+			free(data);
+		}
+	}
+	float heapTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+
+	FrameArena arena(256 * 1024);
+
+	startTime = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frames; frame++) {
+		arena.BeginFrame();
+		for (int i = 0; i < allocationsPerFrame; i++) {
+			unsigned char* data = static_cast<unsigned char*>(arena.Allocate(sizes[i % 4]));
+			data[0] = static_cast<unsigned char>(i);
+			sink = sink + data[0];
+		}
+	}
+	float arenaTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+
+	float allocations = static_cast<float>(frames) * allocationsPerFrame;
+
+	std::cout << "frame-allocation: malloc/free " << heapTime * 1000000000.0f / allocations << " ns"
+		<< ", arena " << arenaTime * 1000000000.0f / allocations << " ns"
+		<< ", speedup " << heapTime / arenaTime
+		<< ", high-water mark " << arena.GetHighWaterMark() << " bytes"
+		<< ", heap fallbacks " << arena.GetOverflowCount() << std::endl;
+}
+
+/*
+* CPU cost of building sprite batches for 10k squares with 4 render states
+* Draw calls go from one per square to one per state
+*/
+void Benchmarks::SpriteBatching() {
+	const size_t quadCount = 10000;
+	const uint32_t stateCount = 4;
+	const int frames = 1000;
+
+	SpriteVertex quad[4] = {
+		{ { -0.03f,  0.05f, 0.5f, 1.0f }, { 0.67f, 0.9f, 0.76f, 1.0f } },
+		{ { -0.06f, -0.05f, 0.5f, 1.0f }, { 0.67f, 0.9f, 0.76f, 1.0f } },
+		{ {  0.03f, -0.05f, 0.5f, 1.0f }, { 0.67f, 0.9f, 0.76f, 1.0f } },
+		{ { -0.06f,  0.05f, 0.5f, 1.0f }, { 0.67f, 0.9f, 0.76f, 1.0f } }
+	};
+
+	// Row-major translations, like world matrices of the objects
+	std::vector<float> worlds(quadCount * 16, 0.0f);
+	for (size_t i = 0; i < quadCount; i++) {
+		float* world = &worlds[i * 16];
+		world[0] = world[5] = world[10] = world[15] = 1.0f;
+		world[12] = (i % 100) * 0.02f - 1.0f;
+		world[13] = (i / 100) * 0.02f - 1.0f;
+	}
+
+	SpriteBatcher batcher;
+
+	auto startTime = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frames; frame++) {
+		batcher.Begin();
+		for (size_t i = 0; i < quadCount; i++)
+			batcher.AddQuad(static_cast<uint32_t>(i % stateCount), quad, &worlds[i * 16]);
+		batcher.End();
+	}
+	float frameTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count() / frames;
+
+	std::cout << "sprite-batching: quads " << quadCount
+		<< ", draws " << quadCount << " -> " << batcher.GetBatches().size()
+		<< ", build " << frameTime * 1000.0f << " ms/frame"
+		<< " (" << frameTime * 1000000000.0f / quadCount << " ns/quad)" << std::endl;
+}
+
+/*
+* Recording and radix sorting 10k draw packets with 8 shaders and 64 buffers in random order
+* Keys are made by Sort(), so the sort time includes the resource id lookups
+* State changes after sorting are counted without a device
+*/
+void Benchmarks::CommandSort() {
+	const size_t packetCount = 10000;
+	const int frames = 200;
+
+	static int shaders[8];
+	static int buffers[64];
+
+	RenderCommandBuffer commands;
+	CountingCommandExecutor executor;
+	std::mt19937 random(1);
+
+	float recordTime = 0;
+	float sortTime = 0;
+
+	for (int frame = 0; frame < frames; frame++) {
+		auto startTime = std::chrono::steady_clock::now();
+
+		commands.Reset();
+		for (size_t i = 0; i < packetCount; i++) {
+			const void* shader = &shaders[random() % 8];
+			const void* buffer = &buffers[random() % 64];
+
+			DrawPacket& packet = commands.Add();
+			packet.vertexShader = shader;
+			packet.pixelShader = shader;
+			packet.vertexBuffer = buffer;
+			packet.indexCount = 6;
+			packet.depth = (random() % 1000) / 1000.0f;
+		}
+
+		auto sortStart = std::chrono::steady_clock::now();
+		commands.Sort();
+		auto endTime = std::chrono::steady_clock::now();
+
+		recordTime += std::chrono::duration<float>(sortStart - startTime).count();
+		sortTime += std::chrono::duration<float>(endTime - sortStart).count();
+	}
+
+	executor.Execute(commands);
+	const IRenderCommandExecutor::Statistics& statistics = executor.GetStatistics();
+
+	std::cout << "command-sort: packets " << packetCount
+		<< ", record " << recordTime / frames * 1000.0f << " ms"
+		<< ", sort " << sortTime / frames * 1000.0f << " ms"
+		<< ", shader changes " << statistics.shaderChanges
+		<< ", vertex buffer changes " << statistics.vertexBufferChanges
+		<< " (unsorted up to " << packetCount << ")" << std::endl;
+}
+
+/*
+* CPU rasterizer throughput on 1 thread and on all hardware threads
+* Random quads of 16..128 pixels over a 1280x720 target
+*/
+void Benchmarks::SoftwareRaster() {
+	const int width = 1280;
+	const int height = 720;
+	const size_t quadCount = 5000;
+	const int frames = 50;
+
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> position(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> size(16.0f, 128.0f);
+	std::uniform_real_distribution<float> channel(0.0f, 1.0f);
+
+	std::vector<SoftwareVertex> vertices;
+	std::vector<uint16_t> indices;
+	for (size_t i = 0; i < quadCount; i++) {
+		float x = position(random);
+		float y = position(random);
+		float w = size(random) * 2.0f / width;
+		float h = size(random) * 2.0f / height;
+		float color[] = { channel(random), channel(random), channel(random), 1.0f };
+
+		float corners[4][2] = { { x + w, y + h }, { x, y }, { x + w, y }, { x, y + h } };
+		for (int j = 0; j < 4; j++)
+			vertices.push_back({ { corners[j][0], corners[j][1], 0.5f, 1.0f }, { color[0], color[1], color[2], color[3] } });
+	}
+
+	uint16_t quadIndices[] = { 0, 1, 2, 1, 0, 3 };
+	for (int i = 0; i < 6; i++)
+		indices.push_back(quadIndices[i]);
+
+	float clearColor[] = { 0.18f, 0.55f, 0.34f, 1.0f };
+	unsigned int threadCounts[] = { 1, 0 };
+
+	for (unsigned int threads : threadCounts) {
+		JobSystem jobSystem(threads);
+		SoftwareRasterizer rasterizer(width, height, &jobSystem);
+
+		unsigned long long pixels = 0;
+		unsigned long long triangles = 0;
+		double seconds = 0;
+
+		for (int frame = 0; frame < frames; frame++) {
+			rasterizer.BeginFrame(clearColor);
+			for (size_t i = 0; i < quadCount; i++)
+				rasterizer.DrawIndexed16(vertices.data(), vertices.size(), indices.data(), indices.size(), static_cast<int>(i * 4), nullptr);
+			rasterizer.EndFrame();
+
+			const SoftwareRasterizer::Statistics& statistics = rasterizer.GetStatistics();
+			pixels += statistics.pixels;
+			triangles += statistics.triangles;
+			seconds += statistics.seconds;
+		}
+
+		std::cout << "software-raster: threads " << jobSystem.GetThreadCount()
+			<< ", " << seconds / frames * 1000.0 << " ms/frame"
+			<< ", " << pixels / seconds / 1000000.0 << " Mpixels/s"
+			<< ", " << triangles / seconds << " triangles/s" << std::endl;
+	}
+}
+
+/*
+* Constants of 2000 packets per frame: a copy into the own buffer of every packet
+* (what UpdateSubresource does per constant buffer) vs slices of one mapped ring
+* Three heap buffers stand for the mapped buffer of frames in flight
+*/
+void Benchmarks::UploadRing() {
+	const int frames = 1000;
+	const size_t packetsPerFrame = 2000;
+	const size_t constantSize = 64; // World matrix
+
+	unsigned char constants[constantSize];
+	for (size_t i = 0; i < constantSize; i++)
+		constants[i] = static_cast<unsigned char>(i);
+
+	volatile unsigned char sink = 0;
+
+	std::vector<std::vector<unsigned char>> ownBuffers(packetsPerFrame, std::vector<unsigned char>(constantSize));
+
+	auto startTime = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frames; frame++) {
+		for (size_t i = 0; i < packetsPerFrame; i++) {
+			constants[0] = static_cast<unsigned char>(i);
+			memcpy(ownBuffers[i].data(), constants, constantSize);
+			sink = sink + ownBuffers[i][0];
+		}
+	}
+	float ownTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+
+	::UploadRing ring(packetsPerFrame * ::UploadRing::ALIGNMENT);
+	std::vector<std::vector<unsigned char>> mappedBuffers(3, std::vector<unsigned char>(ring.GetCapacity()));
+
+	startTime = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frames; frame++) {
+		ring.BeginFrame(mappedBuffers[frame % 3].data());
+		for (size_t i = 0; i < packetsPerFrame; i++) {
+			::UploadRing::Slice slice = ring.Allocate(constantSize);
+			constants[0] = static_cast<unsigned char>(i);
+			memcpy(slice.data, constants, constantSize);
+			sink = sink + static_cast<unsigned char*>(slice.data)[0];
+		}
+		ring.EndFrame();
+	}
+	float ringTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+
+	float packets = static_cast<float>(frames) * packetsPerFrame;
+	const ::UploadRing::Statistics& statistics = ring.GetStatistics();
+
+	std::cout << "upload-ring: own buffers " << ownTime * 1000000000.0f / packets << " ns/packet"
+		<< ", ring " << ringTime * 1000000000.0f / packets << " ns/packet"
+		<< ", peak " << statistics.peakFrameBytes << " bytes/frame"
+		<< ", failed allocations " << statistics.failedAllocations << std::endl;
+}
+
+/*
+* Memory of a large mesh in every vertex layout and the cost of packing it
+*/
+void Benchmarks::VertexPacking() {
+	const size_t vertexCount = 1000000;
+	const int iterations = 20;
+
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> value(0.0f, 1.0f);
+
+	std::vector<float> source(vertexCount * 8);
+	for (float& component : source)
+		component = value(random);
+
+	std::vector<int> indices(vertexCount / 4 * 6);
+	for (size_t i = 0; i < indices.size(); i++)
+		indices[i] = static_cast<int>(i % 0x10000);
+
+	const char* names[] = { "full", "compact", "flat", "tiny" };
+	VertexLayout layouts[] = { VertexLayout::Full(), VertexLayout::Compact(), VertexLayout::Flat(), VertexLayout::Tiny() };
+
+	for (int i = 0; i < 4; i++) {
+		std::vector<unsigned char> packed(vertexCount * layouts[i].GetStride());
+
+		auto startTime = std::chrono::steady_clock::now();
+		for (int j = 0; j < iterations; j++)
+			VertexPacker::Pack(layouts[i], source.data(), vertexCount, packed.data());
+		float packTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+
+		std::cout << "vertex-packing: " << names[i]
+			<< ", stride " << layouts[i].GetStride() << " bytes"
+			<< ", " << packed.size() / (1024 * 1024) << " MB per " << vertexCount << " vertices"
+			<< ", pack " << packTime / iterations * 1000.0f << " ms" << std::endl;
+	}
+
+	std::vector<uint16_t> shortIndices(indices.size());
+	auto startTime = std::chrono::steady_clock::now();
+	for (int j = 0; j < iterations; j++)
+		VertexPacker::PackIndices16(indices.data(), indices.size(), shortIndices.data());
+	float packTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+
+	std::cout << "vertex-packing: indices " << indices.size() * sizeof(int) / 1024 << " KB -> "
+		<< shortIndices.size() * sizeof(uint16_t) / 1024 << " KB"
+		<< ", pack " << packTime / iterations * 1000.0f << " ms" << std::endl;
+}
+
+/*
+* Culling of random boxes around the view volume on the calling thread and on the job system
+*/
+void Benchmarks::FrustumCulling() {
+	const size_t boxCount = 100000;
+	const int frames = 100;
+
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> position(-3.0f, 3.0f);
+	std::uniform_real_distribution<float> size(0.01f, 0.2f);
+
+	std::vector<DirectX::SimpleMath::Matrix> worlds(boxCount);
+	for (DirectX::SimpleMath::Matrix& world : worlds)
+		world = DirectX::SimpleMath::Matrix::CreateScale(size(random)) * DirectX::SimpleMath::Matrix::CreateTranslation(position(random), position(random), 0.5f);
+
+	DirectX::BoundingBox localBounds(DirectX::XMFLOAT3(0, 0, 0), DirectX::XMFLOAT3(1, 1, 0));
+	JobSystem jobSystem;
+	FrustumCuller culler;
+
+	JobSystem* jobSystems[] = { nullptr, &jobSystem };
+	for (JobSystem* system : jobSystems) {
+		float addTime = 0;
+		float cullTime = 0;
+
+		for (int frame = 0; frame < frames; frame++) {
+			auto startTime = std::chrono::steady_clock::now();
+
+			culler.Reset();
+			for (const DirectX::SimpleMath::Matrix& world : worlds)
+				culler.Add(localBounds, world);
+
+			auto cullStart = std::chrono::steady_clock::now();
+			culler.Cull(system);
+			auto endTime = std::chrono::steady_clock::now();
+
+			addTime += std::chrono::duration<float>(cullStart - startTime).count();
+			cullTime += std::chrono::duration<float>(endTime - cullStart).count();
+		}
+
+		std::cout << "frustum-culling: threads " << (system ? system->GetThreadCount() : 1)
+			<< ", boxes " << boxCount
+			<< ", visible " << culler.GetVisibleCount()
+			<< ", add " << addTime / frames * 1000.0f << " ms"
+			<< ", cull " << cullTime / frames * 1000.0f << " ms" << std::endl;
+	}
+}
+
+/*
+* One thread adds and removes handlers while N threads broadcast
+* ConcurrentMulticastDelegate against MulticastDelegate guarded by a mutex
+*/
+void Benchmarks::DelegateContention() {
+	const int handlerCount = 8;
+	const float duration = 0.5f;
+
+	unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<unsigned int> threadCounts = { 1, 2, 4 };
+	if (std::find(threadCounts.begin(), threadCounts.end(), hardwareThreads) == threadCounts.end())
+		threadCounts.push_back(hardwareThreads);
+
+	// Run "broadcast" on "threads" threads and "write" on one more thread for "duration" seconds
+	auto measure = [duration](const char* name, unsigned int threads, std::function<void(int&)> broadcast, std::function<void()> write) {
+		std::atomic<bool> stop(false);
+		std::atomic<unsigned long long> broadcasts(0);
+		unsigned long long writes = 0;
+
+		std::vector<std::thread> broadcasters;
+		for (unsigned int i = 0; i < threads; i++) {
+			broadcasters.emplace_back([&stop, &broadcasts, &broadcast]() {
+				unsigned long long count = 0;
+				int calls = 0; // Handlers count calls per thread, so they don't share a cache line
+				while (!stop.load(std::memory_order_relaxed)) {
+					broadcast(calls);
+					count++;
+				}
+				broadcasts += count;
+			});
+		}
+
+		std::thread writer([&stop, &writes, &write]() {
+			while (!stop.load(std::memory_order_relaxed)) {
+				write();
+				writes++;
+			}
+		});
+
+		std::this_thread::sleep_for(std::chrono::duration<float>(duration));
+		stop = true;
+		writer.join();
+		for (std::thread& broadcaster : broadcasters)
+			broadcaster.join();
+
+		std::cout << "delegate-contention: " << name
+			<< ", broadcasters " << threads
+			<< ", broadcasts/s " << broadcasts / duration
+			<< ", writes/s " << writes / duration << std::endl;
+	};
+
+	for (unsigned int threads : threadCounts) {
+		ConcurrentMulticastDelegate<int&> concurrent;
+		for (int i = 0; i < handlerCount; i++)
+			concurrent.AddLambda([](int& calls) { calls++; });
+
+		measure("copy-on-write", threads,
+			[&concurrent](int& calls) { concurrent.Broadcast(calls); },
+			[&concurrent]() {
+				DelegateHandle handle = concurrent.AddLambda([](int& calls) { calls++; });
+				concurrent.Remove(handle);
+			});
+
+		MulticastDelegate<int&> locked;
+		std::mutex lockedMutex;
+		for (int i = 0; i < handlerCount; i++)
+			locked.AddLambda([](int& calls) { calls++; });
+
+		measure("mutex", threads,
+			[&locked, &lockedMutex](int& calls) {
+				std::lock_guard<std::mutex> lock(lockedMutex);
+				locked.Broadcast(calls);
+			},
+			[&locked, &lockedMutex]() {
+				std::lock_guard<std::mutex> lock(lockedMutex);
+				DelegateHandle handle = locked.AddLambda([](int& calls) { calls++; });
+				locked.Remove(handle);
+			});
+	}
+}
+
+/*
+* Many short-lived subscribers: random Remove + Add between broadcasts
+*/
+void Benchmarks::DelegateChurn() {
+	const int iterations = 20;
+
+	std::mt19937 random(1);
+
+	for (size_t subscriberCount : { 100, 1000, 10000, 100000 }) {
+		MulticastDelegate<int&> delegate;
+		std::vector<DelegateHandle> handles;
+		for (size_t i = 0; i < subscriberCount; i++)
+			handles.push_back(delegate.AddLambda([](int& calls) { calls++; }));
+
+		std::uniform_int_distribution<size_t> index(0, subscriberCount - 1);
+		int calls = 0;
+		float churnTime = 0;
+		float broadcastTime = 0;
+
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			auto startTime = std::chrono::steady_clock::now();
+
+			// Replace a tenth of the subscribers
+			for (size_t i = 0; i < subscriberCount / 10; i++) {
+				DelegateHandle& handle = handles[index(random)];
+				delegate.Remove(handle);
+				handle = delegate.AddLambda([](int& calls) { calls++; });
+			}
+
+			auto broadcastStart = std::chrono::steady_clock::now();
+			delegate.Broadcast(calls);
+			auto endTime = std::chrono::steady_clock::now();
+
+			churnTime += std::chrono::duration<float>(broadcastStart - startTime).count();
+			broadcastTime += std::chrono::duration<float>(endTime - broadcastStart).count();
+		}
+
+		std::cout << "delegate-churn: subscribers " << subscriberCount
+			<< ", remove+add " << churnTime / (iterations * (subscriberCount / 10)) * 1000000000.0f << " ns"
+			<< ", broadcast " << broadcastTime / iterations * 1000000.0f << " us"
+			<< ", calls " << calls << std::endl;
+	}
+}
+
+/*
+* Listener cost of a high polling rate mouse: 8000 packets/s at 60 frames/s
+* Direct broadcast per packet against the event bus policies
+*/
+void Benchmarks::EventCoalescing() {
+	const int frames = 600;
+	const int packetsPerFrame = 8000 / 60;
+	const int listenerCount = 16;
+
+	// Listener with some work, as a camera or UI controller would do
+	float sink = 0;
+	auto listener = [&sink](const InputDevice::MouseMoveEventArgs& args) {
+		float value = args.Offset.x + args.Offset.y;
+		for (int i = 0; i < 50; i++)
+			value = value * 0.99f + 0.01f;
+		sink += value;
+	};
+
+	auto accumulate = [](InputDevice::MouseMoveEventArgs& accumulated, const InputDevice::MouseMoveEventArgs& event) {
+		accumulated.Position = event.Position;
+		accumulated.Offset += event.Offset;
+		accumulated.WheelDelta += event.WheelDelta;
+	};
+
+	auto report = [frames](const char* name, float time, size_t broadcasts) {
+		std::cout << "event-coalescing: " << name
+			<< ", broadcasts/frame " << broadcasts / frames
+			<< ", frame " << time / frames * 1000000.0f << " us" << std::endl;
+	};
+
+	{
+		MulticastDelegate<const InputDevice::MouseMoveEventArgs&> direct;
+		for (int i = 0; i < listenerCount; i++)
+			direct.AddLambda(listener);
+
+		auto startTime = std::chrono::steady_clock::now();
+		for (int frame = 0; frame < frames; frame++)
+			for (int packet = 0; packet < packetsPerFrame; packet++)
+				direct.Broadcast({ DirectX::SimpleMath::Vector2(float(packet), 0), DirectX::SimpleMath::Vector2(1, 1), 0 });
+
+		report("direct", std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count(), size_t(frames) * packetsPerFrame);
+	}
+
+	const std::pair<const char*, EventPolicy> policies[] = {
+		{ "keep all", EventPolicy::KeepAll },
+		{ "coalesce latest", EventPolicy::CoalesceLatest },
+		{ "accumulate deltas", EventPolicy::AccumulateDeltas },
+	};
+
+	for (const std::pair<const char*, EventPolicy>& policy : policies) {
+		EventBus bus;
+		auto channel = bus.Register<InputDevice::MouseMoveEventArgs>(policy.second, accumulate);
+		for (int i = 0; i < listenerCount; i++)
+			channel->Listeners.AddLambda(listener);
+
+		auto startTime = std::chrono::steady_clock::now();
+		for (int frame = 0; frame < frames; frame++) {
+			for (int packet = 0; packet < packetsPerFrame; packet++)
+				channel->Enqueue({ DirectX::SimpleMath::Vector2(float(packet), 0), DirectX::SimpleMath::Vector2(1, 1), 0 });
+			bus.Dispatch();
+		}
+
+		report(policy.first, std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count(), bus.GetStatistics().dispatched);
+	}
+
+	if (sink == 0)
+		std::cout << "event-coalescing: no listener calls" << std::endl;
+}
+
+/*
+* Delegate against std::function: free function, small lambda, lambda with std::shared_ptr
+* and a 48 byte capture (heap in Delegate, inline in SizedDelegate<64>)
+*/
+void Benchmarks::DelegateBinding() {
+	// Delegate is called with Execute(), std::function with operator()
+	struct Callable : Delegate<int, int> {
+		Callable() = default;
+		Callable(Delegate<int, int>&& other) : Delegate<int, int>(std::move(other)) {}
+		int operator()(int value) const { return Execute(value); }
+	};
+	struct Callable64 : SizedDelegate<64, int, int> {
+		Callable64() = default;
+		Callable64(SizedDelegate<64, int, int>&& other) : SizedDelegate<64, int, int>(std::move(other)) {}
+		int operator()(int value) const { return Execute(value); }
+	};
+	using Function = std::function<int(int)>;
+
+	std::shared_ptr<int> shared = std::make_shared<int>(1);
+	struct Capture48 { int values[12]; };
+
+	MeasureDelegate<Callable>("delegate, function", [](int i) { return Callable(Delegate<int, int>::CreateStatic(&BenchmarkAdd, i)); });
+	MeasureDelegate<Function>("std::function, function", [](int i) { return Function(std::bind(&BenchmarkAdd, std::placeholders::_1, i)); });
+
+	MeasureDelegate<Callable>("delegate, small lambda", [](int i) { return Callable(Delegate<int, int>::CreateLambda([i](int value) { return value + i; })); });
+	MeasureDelegate<Function>("std::function, small lambda", [](int i) { return Function([i](int value) { return value + i; }); });
+
+	MeasureDelegate<Callable>("delegate, shared_ptr lambda", [&shared](int) { return Callable(Delegate<int, int>::CreateLambda([shared](int value) { return value + *shared; })); });
+	MeasureDelegate<Function>("std::function, shared_ptr lambda", [&shared](int) { return Function([shared](int value) { return value + *shared; }); });
+
+	MeasureDelegate<Callable>("delegate, 48 byte lambda", [](int i) { Capture48 c = { { i } }; return Callable(Delegate<int, int>::CreateLambda([c](int value) { return value + c.values[0]; })); });
+	MeasureDelegate<Callable64>("delegate<64>, 48 byte lambda", [](int i) { Capture48 c = { { i } }; return Callable64(SizedDelegate<64, int, int>::CreateLambda([c](int value) { return value + c.values[0]; })); });
+	MeasureDelegate<Function>("std::function, 48 byte lambda", [](int i) { Capture48 c = { { i } }; return Function([c](int value) { return value + c.values[0]; }); });
+}
+
+/*
+* Per-call cost of bound delegates against a direct call through a function pointer
+*/
+void Benchmarks::DelegateInvocation() {
+	const int calls = 100000000;
+
+	// "volatile", so the compiler can't inline the baseline call
+	int(*volatile pointer)(int, int) = &BenchmarkAdd;
+	int(*function)(int, int) = pointer;
+
+	BenchmarkCounter counter;
+	std::shared_ptr<BenchmarkCounter> sharedCounter = std::make_shared<BenchmarkCounter>();
+
+	Delegate<int, int> staticDelegate = Delegate<int, int>::CreateStatic(function, 1);
+	Delegate<int, int> rawDelegate = Delegate<int, int>::CreateRaw(&counter, &BenchmarkCounter::Add);
+	Delegate<int, int> compileTimeRawDelegate = Delegate<int, int>::CreateRaw<BenchmarkCounter, &BenchmarkCounter::Add>(&counter);
+	Delegate<int, int> lambdaDelegate = Delegate<int, int>::CreateLambda([&counter](int value) { return counter.Add(value); });
+	Delegate<int, int> spDelegate = Delegate<int, int>::CreateSP(sharedCounter, &BenchmarkCounter::Add);
+	std::function<int(int)> stdFunction = std::bind(function, std::placeholders::_1, 1);
+
+	std::cout << "delegate-invocation: function pointer " << MeasureCalls(calls, [function](int i) { return function(i, 1); }) << " ns"
+		<< ", static " << MeasureCalls(calls, [&staticDelegate](int i) { return staticDelegate.Execute(i); }) << " ns"
+		<< ", raw " << MeasureCalls(calls, [&rawDelegate](int i) { return rawDelegate.Execute(i); }) << " ns"
+		<< ", raw (compile-time) " << MeasureCalls(calls, [&compileTimeRawDelegate](int i) { return compileTimeRawDelegate.Execute(i); }) << " ns"
+		<< ", lambda " << MeasureCalls(calls, [&lambdaDelegate](int i) { return lambdaDelegate.Execute(i); }) << " ns"
+		<< ", shared_ptr " << MeasureCalls(calls, [&spDelegate](int i) { return spDelegate.Execute(i); }) << " ns"
+		<< ", std::function " << MeasureCalls(calls, [&stdFunction](int i) { return stdFunction(i); }) << " ns" << std::endl;
+}
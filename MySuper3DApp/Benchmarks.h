@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+
+/*
+* Headless benchmarks of the engine parts
+* Started from the command line: MySuper3DApp.exe --benchmark <name>
+*/
+class Benchmarks {
+public:
+	static bool Run(const std::string& name);
+
+	static void FixedTick();
+	static void HeadlessFrames();
+	static void JobScaling();
+	static void EntityIteration();
+	static void FrameAllocation();
+	static void SpriteBatching();
+	static void CommandSort();
+	static void SoftwareRaster();
+	static void UploadRing();
+	static void VertexPacking();
+	static void FrustumCulling();
+	static void DelegateContention();
+	static void DelegateChurn();
+	static void EventCoalescing();
+	static void DelegateBinding();
+	static void DelegateInvocation();
+};
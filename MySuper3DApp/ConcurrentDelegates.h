@@ -0,0 +1,329 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Delegates.h"
+
+/*
+* Epoch-based reclamation shared by all concurrent delegates
+* A reading thread announces the global epoch in its slot while it broadcasts,
+* an unlinked snapshot is freed when every announced epoch is newer than its retire epoch
+* Slots are claimed once per thread, threads beyond MAX_READERS fall back to a shared counter
+* that only delays reclamation
+*/
+class DelegateEpochs {
+public:
+	static const unsigned int MAX_READERS = 64;
+	static const uint64_t IDLE = ~0ull;
+
+private:
+	struct alignas(64) Slot {
+		std::atomic<uint64_t> epoch; // IDLE when the thread is not reading
+		std::atomic<bool> claimed;
+	};
+
+	// Releases the slot of the thread when it exits
+	struct ThreadSlot {
+		int index = -1;
+		unsigned int depth = 0; // Nested broadcasts announce once
+
+		~ThreadSlot() {
+			if (index >= 0)
+				Get().slots[index].claimed.store(false, std::memory_order_release);
+		}
+	};
+
+	std::atomic<uint64_t> globalEpoch;
+	std::atomic<unsigned int> overflowReaders; // Readers without a slot
+	Slot slots[MAX_READERS];
+
+	DelegateEpochs() : globalEpoch(0), overflowReaders(0) {
+		for (Slot& slot : slots) {
+			slot.epoch.store(IDLE);
+			slot.claimed.store(false);
+		}
+	}
+
+	static ThreadSlot& GetThreadSlot() {
+		static thread_local ThreadSlot threadSlot;
+		return threadSlot;
+	}
+
+	// Bounded loop: wait-free
+	int ClaimSlot() {
+		for (unsigned int i = 0; i < MAX_READERS; i++) {
+			bool expected = false;
+			if (!slots[i].claimed.load(std::memory_order_relaxed) && slots[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+				return static_cast<int>(i);
+		}
+		return -1;
+	}
+
+public:
+	static DelegateEpochs& Get() {
+		static DelegateEpochs epochs;
+		return epochs;
+	}
+
+	void EnterRead() {
+		ThreadSlot& threadSlot = GetThreadSlot();
+		if (threadSlot.depth++ > 0)
+			return;
+
+		if (threadSlot.index < 0)
+			threadSlot.index = ClaimSlot();
+
+		if (threadSlot.index >= 0)
+			slots[threadSlot.index].epoch.store(globalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+		else
+			overflowReaders.fetch_add(1, std::memory_order_seq_cst);
+	}
+
+	void ExitRead() {
+		ThreadSlot& threadSlot = GetThreadSlot();
+		if (--threadSlot.depth > 0)
+			return;
+
+		if (threadSlot.index >= 0)
+			slots[threadSlot.index].epoch.store(IDLE, std::memory_order_release);
+		else
+			overflowReaders.fetch_sub(1, std::memory_order_release);
+	}
+
+	// Call after the old snapshot is unlinked, returns its retire epoch
+	uint64_t Advance() {
+		return globalEpoch.fetch_add(1, std::memory_order_seq_cst);
+	}
+
+	// Snapshots retired at "epoch" can't be reached by readers any more
+	bool IsSafe(uint64_t epoch) {
+		if (overflowReaders.load(std::memory_order_seq_cst) > 0)
+			return false;
+
+		for (const Slot& slot : slots)
+			if (slot.epoch.load(std::memory_order_seq_cst) <= epoch)
+				return false;
+
+		return true;
+	}
+};
+
+/*
+* MulticastDelegate that can be broadcast from any thread while other threads add and remove handlers
+* Broadcast() reads an immutable snapshot of the handlers, published atomically: no locks, wait-free
+* Writers are serialized by a mutex, copy the snapshot, change the copy and publish it,
+* old snapshots are freed by epoch-based reclamation
+* A handler removed during a broadcast may still be called by that broadcast
+*/
+template<typename... Args>
+class ConcurrentMulticastDelegate {
+public:
+	using DelegateT = Delegate<void, Args...>;
+
+private:
+	struct Entry {
+		DelegateHandle handle;
+		std::shared_ptr<const DelegateT> callback; // Shared between snapshots, never copied
+	};
+
+	struct Snapshot {
+		std::vector<Entry> entries;
+		uint64_t retireEpoch;
+	};
+
+	template<typename T, typename... Args2>
+	using ConstMemberFunction = typename _DelegatesInteral::MemberFunction<true, T, void, Args..., Args2...>::Type;
+	template<typename T, typename... Args2>
+	using NonConstMemberFunction = typename _DelegatesInteral::MemberFunction<false, T, void, Args..., Args2...>::Type;
+
+	std::atomic<Snapshot*> current;
+	std::mutex writeMutex;
+	std::vector<Snapshot*> retired; // Guarded by "writeMutex"
+	std::vector<unsigned int> generations; // Of handle slots, guarded by "writeMutex"
+	std::vector<unsigned int> freeSlots; // Guarded by "writeMutex"
+
+	// Under "writeMutex"
+	void Publish(Snapshot* snapshot) {
+		Snapshot* old = current.exchange(snapshot, std::memory_order_seq_cst);
+		old->retireEpoch = DelegateEpochs::Get().Advance();
+		retired.push_back(old);
+		Reclaim();
+	}
+
+	void Reclaim() {
+		size_t kept = 0;
+		for (Snapshot* snapshot : retired) {
+			if (DelegateEpochs::Get().IsSafe(snapshot->retireEpoch))
+				delete snapshot;
+			else
+				retired[kept++] = snapshot;
+		}
+		retired.resize(kept);
+	}
+
+	// Under "writeMutex"
+	DelegateHandle AllocateHandle() {
+		unsigned int slot;
+		if (!freeSlots.empty()) {
+			slot = freeSlots.back();
+			freeSlots.pop_back();
+		}
+		else {
+			slot = static_cast<unsigned int>(generations.size());
+			generations.push_back(0);
+		}
+		return DelegateHandle(slot, generations[slot]);
+	}
+
+	// Under "writeMutex", a slot whose generation would wrap is never reused
+	void FreeHandle(const DelegateHandle& handle) {
+		if (++generations[handle.GetIndex()] != 0)
+			freeSlots.push_back(handle.GetIndex());
+	}
+
+	// Under "writeMutex"
+	Snapshot* Copy() const {
+		return new Snapshot(*current.load(std::memory_order_acquire));
+	}
+
+public:
+	ConcurrentMulticastDelegate() : current(new Snapshot()) {}
+
+	// No broadcasts may run
+	~ConcurrentMulticastDelegate() {
+		delete current.load();
+		for (Snapshot* snapshot : retired)
+			delete snapshot;
+	}
+
+	ConcurrentMulticastDelegate(const ConcurrentMulticastDelegate&) = delete;
+	ConcurrentMulticastDelegate& operator=(const ConcurrentMulticastDelegate&) = delete;
+
+	DelegateHandle Add(DelegateT&& handler) {
+		std::lock_guard<std::mutex> lock(writeMutex);
+
+		Snapshot* snapshot = Copy();
+		DelegateHandle handle = AllocateHandle();
+		snapshot->entries.push_back({ handle, std::make_shared<const DelegateT>(std::move(handler)) });
+		Publish(snapshot);
+
+		return handle;
+	}
+
+	template<typename T, typename... Args2>
+	DelegateHandle AddRaw(T* pObject, NonConstMemberFunction<T, Args2...> pFunction, Args2&&... args) {
+		return Add(DelegateT::CreateRaw(pObject, pFunction, std::forward<Args2>(args)...));
+	}
+
+	template<typename T, typename... Args2>
+	DelegateHandle AddRaw(T* pObject, ConstMemberFunction<T, Args2...> pFunction, Args2&&... args) {
+		return Add(DelegateT::CreateRaw(pObject, pFunction, std::forward<Args2>(args)...));
+	}
+
+	template<typename... Args2>
+	DelegateHandle AddStatic(void(*pFunction)(Args..., Args2...), Args2&&... args) {
+		return Add(DelegateT::CreateStatic(pFunction, std::forward<Args2>(args)...));
+	}
+
+	template<typename LambdaType, typename... Args2>
+	DelegateHandle AddLambda(LambdaType&& lambda, Args2&&... args) {
+		return Add(DelegateT::CreateLambda(std::forward<LambdaType>(lambda), std::forward<Args2>(args)...));
+	}
+
+	template<typename T, typename... Args2>
+	DelegateHandle AddSP(std::shared_ptr<T> pObject, NonConstMemberFunction<T, Args2...> pFunction, Args2&&... args) {
+		return Add(DelegateT::CreateSP(pObject, pFunction, std::forward<Args2>(args)...));
+	}
+
+	template<typename T, typename... Args2>
+	DelegateHandle AddSP(std::shared_ptr<T> pObject, ConstMemberFunction<T, Args2...> pFunction, Args2&&... args) {
+		return Add(DelegateT::CreateSP(pObject, pFunction, std::forward<Args2>(args)...));
+	}
+
+	bool Remove(DelegateHandle& handle) {
+		if (!handle.IsValid())
+			return false;
+
+		std::lock_guard<std::mutex> lock(writeMutex);
+
+		const std::vector<Entry>& entries = current.load(std::memory_order_acquire)->entries;
+		for (size_t i = 0; i < entries.size(); i++) {
+			if (entries[i].handle == handle) {
+				Snapshot* snapshot = Copy();
+				snapshot->entries.erase(snapshot->entries.begin() + i);
+				Publish(snapshot);
+				FreeHandle(handle);
+
+				handle.Reset();
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Only Raw and SP bindings have an owner
+	void RemoveObject(void* pObject) {
+		if (pObject == nullptr)
+			return;
+
+		std::lock_guard<std::mutex> lock(writeMutex);
+
+		Snapshot* snapshot = Copy();
+		size_t kept = 0;
+		for (size_t i = 0; i < snapshot->entries.size(); i++) {
+			if (snapshot->entries[i].callback->GetOwner() == pObject)
+				FreeHandle(snapshot->entries[i].handle);
+			else if (kept++ != i)
+				snapshot->entries[kept - 1] = std::move(snapshot->entries[i]);
+		}
+		snapshot->entries.resize(kept);
+
+		Publish(snapshot);
+	}
+
+	void RemoveAll() {
+		std::lock_guard<std::mutex> lock(writeMutex);
+		for (const Entry& entry : current.load(std::memory_order_acquire)->entries)
+			FreeHandle(entry.handle);
+		Publish(new Snapshot());
+	}
+
+	bool IsBoundTo(const DelegateHandle& handle) const {
+		if (!handle.IsValid())
+			return false;
+
+		DelegateEpochs::Get().EnterRead();
+		bool found = false;
+		for (const Entry& entry : current.load(std::memory_order_seq_cst)->entries)
+			found = found || entry.handle == handle;
+		DelegateEpochs::Get().ExitRead();
+
+		return found;
+	}
+
+	void Broadcast(Args... args) const {
+		DelegateEpochs::Get().EnterRead();
+
+		const Snapshot* snapshot = current.load(std::memory_order_seq_cst);
+		for (const Entry& entry : snapshot->entries)
+			entry.callback->Execute(args...);
+
+		DelegateEpochs::Get().ExitRead();
+	}
+
+	size_t GetSize() const {
+		DelegateEpochs::Get().EnterRead();
+		size_t size = current.load(std::memory_order_seq_cst)->entries.size();
+		DelegateEpochs::Get().ExitRead();
+
+		return size;
+	}
+
+	size_t GetRetiredCount() {
+		std::lock_guard<std::mutex> lock(writeMutex);
+		return retired.size();
+	}
+};
@@ -0,0 +1,172 @@
+#include "D3D11CommandExecutor.h"
+#include <algorithm>
+#include <cstring>
+
+D3D11CommandExecutor::D3D11CommandExecutor(Microsoft::WRL::ComPtr<ID3D11Device> device, std::shared_ptr<StateFilteredContext> context, std::shared_ptr<D3D11ConstantRing> constantRing) {
+	this->device = device;
+	this->context = context;
+	this->constantRing = constantRing;
+	transientCapacity = 0;
+	transientOffset = 0;
+	statistics = {};
+}
+
+/*
+* One map for the whole frame: the ring buffer can't be mapped while draws read it
+*/
+void D3D11CommandExecutor::UploadConstants(const RenderCommandBuffer& commands) {
+	slices.assign(commands.GetCount(), { nullptr, 0, 0 });
+
+	if (!constantRing || !constantRing->BeginFrame())
+		return;
+
+	for (size_t i = 0; i < commands.GetCount(); i++) {
+		const DrawPacket& packet = commands.GetSorted(i);
+		if (packet.constantBuffer)
+			slices[i] = constantRing->Allocate(packet.constants, sizeof(packet.constants));
+	}
+
+	constantRing->EndFrame();
+}
+
+/*
+* Packets of one stream (all batches of a sprite batcher) share its upload, streams come in runs after sorting
+* One map for all streams of the frame, the buffer grows when they don't fit
+*/
+bool D3D11CommandExecutor::UploadTransientVertices(const RenderCommandBuffer& commands) {
+	transientOffsets.assign(commands.GetCount(), 0);
+
+	UINT size = 0;
+	const void* previous = nullptr;
+	for (size_t i = 0; i < commands.GetCount(); i++) {
+		const DrawPacket& packet = commands.GetSorted(i);
+		if (!(packet.flags & DrawPacket::TRANSIENT_VERTICES) || packet.vertexBuffer == previous)
+			continue;
+
+		size += packet.vertexCount * packet.vertexStride;
+		previous = packet.vertexBuffer;
+	}
+
+	if (size == 0)
+		return true;
+
+	if (size > transientCapacity) {
+		D3D11_BUFFER_DESC bufferDesc = {};
+		bufferDesc.ByteWidth = std::max(size, transientCapacity * 2);
+		bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+		bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+		transientBuffer.Reset();
+		transientCapacity = 0;
+		if (FAILED(device->CreateBuffer(&bufferDesc, nullptr, transientBuffer.GetAddressOf())))
+			return false;
+
+		transientCapacity = bufferDesc.ByteWidth;
+		transientOffset = transientCapacity; // The first map of a new buffer must discard
+	}
+
+	// Append behind the data the GPU may still read, restart with discard when the ring is full
+	D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+	if (transientOffset + size > transientCapacity) {
+		mapType = D3D11_MAP_WRITE_DISCARD;
+		transientOffset = 0;
+	}
+
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (FAILED(context->GetContext()->Map(transientBuffer.Get(), 0, mapType, 0, &mapped)))
+		return false;
+
+	previous = nullptr;
+	UINT streamOffset = transientOffset;
+	for (size_t i = 0; i < commands.GetCount(); i++) {
+		const DrawPacket& packet = commands.GetSorted(i);
+		if (!(packet.flags & DrawPacket::TRANSIENT_VERTICES))
+			continue;
+
+		if (packet.vertexBuffer != previous) {
+			streamOffset = transientOffset;
+			UINT bytes = packet.vertexCount * packet.vertexStride;
+			memcpy(static_cast<unsigned char*>(mapped.pData) + streamOffset, packet.vertexBuffer, bytes);
+			transientOffset += bytes;
+			previous = packet.vertexBuffer;
+		}
+
+		transientOffsets[i] = streamOffset;
+	}
+
+	context->GetContext()->Unmap(transientBuffer.Get(), 0);
+
+	return true;
+}
+
+void D3D11CommandExecutor::Execute(const RenderCommandBuffer& commands) {
+	statistics = {};
+
+	if (commands.GetCount() == 0)
+		return;
+
+	UploadConstants(commands);
+	bool transientUploaded = UploadTransientVertices(commands);
+
+	context->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	const DrawPacket* previous = nullptr;
+	for (size_t i = 0; i < commands.GetCount(); i++) {
+		const DrawPacket& packet = commands.GetSorted(i);
+
+		// Without geometry (failed sprite state or a failed transient upload) there is nothing to draw
+		bool transient = (packet.flags & DrawPacket::TRANSIENT_VERTICES) != 0;
+		if (!packet.vertexBuffer || !packet.indexBuffer || (transient && !transientUploaded))
+			continue;
+
+		if (!previous || packet.vertexShader != previous->vertexShader || packet.pixelShader != previous->pixelShader) {
+			context->VSSetShader(static_cast<ID3D11VertexShader*>(const_cast<void*>(packet.vertexShader)));
+			context->PSSetShader(static_cast<ID3D11PixelShader*>(const_cast<void*>(packet.pixelShader)));
+			statistics.shaderChanges++;
+		}
+
+		if (!previous || packet.inputLayout != previous->inputLayout) {
+			context->IASetInputLayout(static_cast<ID3D11InputLayout*>(const_cast<void*>(packet.inputLayout)));
+			statistics.layoutChanges++;
+		}
+
+		if (!previous || packet.rasterizerState != previous->rasterizerState) {
+			context->RSSetState(static_cast<ID3D11RasterizerState*>(const_cast<void*>(packet.rasterizerState)));
+			statistics.rasterizerChanges++;
+		}
+
+		if (!previous || packet.vertexBuffer != previous->vertexBuffer || packet.vertexStride != previous->vertexStride) {
+			ID3D11Buffer* vertexBuffer = transient ? transientBuffer.Get() : static_cast<ID3D11Buffer*>(const_cast<void*>(packet.vertexBuffer));
+			UINT strides[1] = { packet.vertexStride };
+			UINT offsets[1] = { transient ? transientOffsets[i] : 0 };
+			context->IASetVertexBuffers(0, 1, &vertexBuffer, strides, offsets);
+			statistics.vertexBufferChanges++;
+		}
+
+		if (!previous || packet.indexBuffer != previous->indexBuffer || packet.indexFormat != previous->indexFormat) {
+			context->IASetIndexBuffer(static_cast<ID3D11Buffer*>(const_cast<void*>(packet.indexBuffer)), static_cast<DXGI_FORMAT>(packet.indexFormat), 0);
+			statistics.indexBufferChanges++;
+		}
+
+		if (slices[i].data) {
+			constantRing->BindVS(*context, 0, slices[i]);
+			statistics.constantUploads++;
+		}
+		else if (packet.constantBuffer) {
+			ID3D11Buffer* constantBuffer = static_cast<ID3D11Buffer*>(const_cast<void*>(packet.constantBuffer));
+			context->GetContext()->UpdateSubresource(constantBuffer, 0, nullptr, packet.constants, 0, 0);
+			context->VSSetConstantBuffers(0, 1, &constantBuffer);
+			statistics.constantUploads++;
+		}
+
+		context->DrawIndexed(packet.indexCount, packet.startIndex, packet.baseVertex);
+		statistics.draws++;
+
+		previous = &packet;
+	}
+}
+
+const IRenderCommandExecutor::Statistics& D3D11CommandExecutor::GetStatistics() const {
+	return statistics;
+}
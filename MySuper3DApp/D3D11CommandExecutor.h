@@ -0,0 +1,39 @@
+#pragma once
+#include <wrl.h>
+#include <d3d11.h>
+#include <memory>
+#include <vector>
+#include "RenderCommandBuffer.h"
+#include "D3D11ConstantRing.h"
+#include "StateFilteredContext.h"
+
+/*
+* Replays draw packets on a "Direct3D 11" context
+* State equal to the previous packet is not set again, binds go through the state filter
+* Constants of all packets are written to the upload ring before the first draw,
+* packets that don't fit fall back to UpdateSubresource on their own buffer
+* Transient vertices (sprite batches) are copied into one dynamic vertex buffer, used as a ring
+* (no-overwrite appends, discard on wrap), every CPU stream once per frame
+*/
+class D3D11CommandExecutor : public IRenderCommandExecutor {
+	Microsoft::WRL::ComPtr<ID3D11Device> device;
+	std::shared_ptr<StateFilteredContext> context;
+	std::shared_ptr<D3D11ConstantRing> constantRing; // nullptr - UpdateSubresource for every packet
+	std::vector<UploadRing::Slice> slices; // Constant slices of sorted packets
+
+	Microsoft::WRL::ComPtr<ID3D11Buffer> transientBuffer;
+	UINT transientCapacity; // Bytes in "transientBuffer"
+	UINT transientOffset; // Ring position for the next upload
+	std::vector<UINT> transientOffsets; // Byte offset of the vertices of sorted packets in "transientBuffer"
+
+	Statistics statistics;
+
+	void UploadConstants(const RenderCommandBuffer& commands);
+	bool UploadTransientVertices(const RenderCommandBuffer& commands); // false if they can't be drawn
+
+public:
+	D3D11CommandExecutor(Microsoft::WRL::ComPtr<ID3D11Device> device, std::shared_ptr<StateFilteredContext> context, std::shared_ptr<D3D11ConstantRing> constantRing);
+
+	void Execute(const RenderCommandBuffer& commands) override;
+	const Statistics& GetStatistics() const override;
+};
@@ -0,0 +1,74 @@
+#include "D3D11ConstantRing.h"
+#include <cstring>
+
+const size_t D3D11ConstantRing::DEFAULT_CAPACITY;
+
+D3D11ConstantRing::D3D11ConstantRing(size_t capacity) : ring(capacity) {
+	mapped = false;
+}
+
+bool D3D11ConstantRing::Initialize(Microsoft::WRL::ComPtr<ID3D11Device> device, Microsoft::WRL::ComPtr<ID3D11DeviceContext> context) {
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+	HRESULT res = device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+	if (FAILED(res) || !options.ConstantBufferOffsetting)
+		return false;
+
+	res = context.As(&this->context);
+	if (FAILED(res))
+		return false;
+
+	D3D11_BUFFER_DESC bufferDesc = {};
+	bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+	bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	bufferDesc.MiscFlags = 0;
+	bufferDesc.StructureByteStride = 0;
+	bufferDesc.ByteWidth = static_cast<UINT>(ring.GetCapacity());
+
+	res = device->CreateBuffer(&bufferDesc, nullptr, buffer.GetAddressOf());
+	return SUCCEEDED(res);
+}
+
+/*
+* Discard gives a new buffer, so the GPU can still read slices of the previous frame
+*/
+bool D3D11ConstantRing::BeginFrame() {
+	D3D11_MAPPED_SUBRESOURCE resource = {};
+	HRESULT res = context->Map(buffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &resource);
+	if (FAILED(res))
+		return false;
+
+	ring.BeginFrame(resource.pData);
+	mapped = true;
+	return true;
+}
+
+UploadRing::Slice D3D11ConstantRing::Allocate(const void* data, size_t size) {
+	UploadRing::Slice slice = ring.Allocate(size);
+	if (slice.data)
+		memcpy(slice.data, data, size);
+
+	return slice;
+}
+
+void D3D11ConstantRing::EndFrame() {
+	if (!mapped)
+		return;
+
+	ring.EndFrame();
+	context->Unmap(buffer.Get(), 0);
+	mapped = false;
+}
+
+/*
+* Offset and size are in 16-byte constants, both multiples of 16 for 256-byte slices
+*/
+void D3D11ConstantRing::BindVS(StateFilteredContext& context, UINT slot, const UploadRing::Slice& slice) {
+	UINT firstConstant = static_cast<UINT>(slice.offset / 16);
+	UINT constantCount = static_cast<UINT>(slice.size / 16);
+	context.VSSetConstantBuffers1(slot, 1, buffer.GetAddressOf(), &firstConstant, &constantCount);
+}
+
+const UploadRing& D3D11ConstantRing::GetRing() const {
+	return ring;
+}
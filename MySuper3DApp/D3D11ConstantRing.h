@@ -0,0 +1,33 @@
+#pragma once
+#include <wrl.h>
+#include <d3d11_1.h>
+#include "UploadRing.h"
+#include "StateFilteredContext.h"
+
+/*
+* Per-frame upload ring for constant buffer data
+* One large dynamic buffer is map-discarded once per frame, draws take 256-byte slices of it
+* and bind them by offset with VSSetConstantBuffers1 ("Direct3D 11.1")
+* Replaces UpdateSubresource on small per-component buffers
+*/
+class D3D11ConstantRing {
+	Microsoft::WRL::ComPtr<ID3D11DeviceContext1> context;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+	UploadRing ring;
+	bool mapped;
+
+public:
+	static const size_t DEFAULT_CAPACITY = 1024 * 1024; // 4096 slices
+
+	D3D11ConstantRing(size_t capacity = DEFAULT_CAPACITY);
+
+	bool Initialize(Microsoft::WRL::ComPtr<ID3D11Device> device, Microsoft::WRL::ComPtr<ID3D11DeviceContext> context); // false if offsets are not supported
+
+	bool BeginFrame(); // Map with discard
+	UploadRing::Slice Allocate(const void* data, size_t size); // Copy data into a new slice
+	void EndFrame(); // Unmap, slices can be bound after that
+
+	void BindVS(StateFilteredContext& context, UINT slot, const UploadRing::Slice& slice);
+
+	const UploadRing& GetRing() const;
+};
@@ -0,0 +1,326 @@
+#include "D3D11GraphicsBackend.h"
+#include "DisplayWin32.h"
+#include "ShaderLibrary.h"
+#include "Platform.h"
+#include "MeshRegistry.h"
+#include "D3D11StateCache.h"
+#include "StateFilteredContext.h"
+#include "D3D11ConstantRing.h"
+#include "D3D11CommandExecutor.h"
+#include "SpriteRenderer.h"
+#include "SimpleMath.h"
+#include <iostream>
+
+#pragma comment(lib, "d3d11.lib")
+#pragma comment(lib, "dxgi.lib")
+#pragma comment(lib, "dxguid.lib")
+
+/*
+* Mesh on the device
+* Holds references to the objects behind the opaque pointers of "RenderMesh"
+*/
+class D3D11RenderMesh : public RenderMesh {
+public:
+	Microsoft::WRL::ComPtr<ID3D11InputLayout> layout;
+	Microsoft::WRL::ComPtr<ID3D11PixelShader> pixelShaderObject; // Shared through "ShaderLibrary"
+	Microsoft::WRL::ComPtr<ID3D11VertexShader> vertexShaderObject;
+	Microsoft::WRL::ComPtr<ID3D11RasterizerState> rastState;
+	std::shared_ptr<const MeshBuffer> vertexMesh; // Shared with other meshes of the same geometry
+	std::shared_ptr<const MeshBuffer> indexMesh;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> constBuf;
+};
+
+/*
+* Create device, swap chain and back buffer render target for the window
+*/
+D3D11GraphicsBackend::D3D11GraphicsBackend(std::shared_ptr<DisplayWin32> display, bool windowed) {
+	this->display = display;
+	viewport = std::make_shared<D3D11_VIEWPORT>();
+	swapDesc = std::make_shared<DXGI_SWAP_CHAIN_DESC>();
+	vsync = true;
+
+	// Initialize viewport parameters
+	viewport->TopLeftX = 0; // X position of the left hand side of the viewport
+	viewport->TopLeftY = 0; // Y position of the top of the viewport
+	viewport->Width = static_cast<float>(display->GetClientWidth()); // Width of the viewport
+	viewport->Height = static_cast<float>(display->GetClientHeight()); // Height of the viewport
+	viewport->MinDepth = 0; // Minimum depth of the viewport. Ranges between 0 and 1
+	viewport->MaxDepth = 1.0f; // Maximum depth of the viewport. Ranges between 0 and 1
+
+	// BufferDesc describes the backbuffer display mode
+	swapDesc->BufferDesc.Width = display->GetClientWidth(); // Resolution width
+	swapDesc->BufferDesc.Height = display->GetClientHeight(); // Resolution height
+	swapDesc->BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; // Display format (32-bit unsigned normalized integer format supporting 8 bits per channel, including the alpha channel)
+	swapDesc->BufferDesc.RefreshRate.Numerator = 60; // Refresh rate in hertz numerator
+	swapDesc->BufferDesc.RefreshRate.Denominator = 1; // Refresh rate in hertz denominator (for representing integer it = 1)
+	swapDesc->BufferDesc.ScanlineOrdering = DXGI_MODE_SCANLINE_ORDER_UNSPECIFIED; // Scanline drawing mode (indicating the method the raster uses to create an image on a surface)
+	swapDesc->BufferDesc.Scaling = DXGI_MODE_SCALING_UNSPECIFIED; // Scaling mode (indicating how an image is stretched to fit a given monitor's resolution)
+
+	/* 
+	* SampleDesc describes multi - sampling parameters for a resource
+	* The default sampler mode, with no anti-aliasing, has a count of 1 and a quality level of 0
+	*/
+	swapDesc->SampleDesc.Count = 1; // Number of multisamples per pixel
+	swapDesc->SampleDesc.Quality = 0; // The image quality level. The higher the quality, the lower the performance
+
+	swapDesc->BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT; // Describes the surface usage and CPU access options for the back buffer
+	swapDesc->BufferCount = 2; // Number of buffers in the swap chain (double or triple buffering)
+	swapDesc->OutputWindow = display->GetHWnd(); // Handle to the output window. This member must not be NULL.
+	swapDesc->Windowed = windowed;
+	swapDesc->SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD; // Describes options for handling the contents of the presentation buffer after presenting a surface
+	swapDesc->Flags = DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH; // Options for swap-chain behavior
+
+	const int featureLevelsNumber = 1;
+	D3D_FEATURE_LEVEL featureLevels[featureLevelsNumber] = { D3D_FEATURE_LEVEL_11_1 };
+
+	// Creates a device that represents the display adapter and a swap chain used for rendering
+	res = D3D11CreateDeviceAndSwapChain(
+		nullptr,
+		D3D_DRIVER_TYPE_HARDWARE,
+		nullptr,
+		D3D11_CREATE_DEVICE_DEBUG,
+		featureLevels, // Determine the order of feature levels to attempt to create
+		featureLevelsNumber, // The number of elements in feature levels array
+		D3D11_SDK_VERSION,
+		swapDesc.get(),
+		swapChain.GetAddressOf(),
+		device.GetAddressOf(),
+		nullptr, // Feature level for device
+		context.GetAddressOf()
+	);
+
+	if (FAILED(res)) {
+		// Well, that was unexpected
+	}
+	
+	res = swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)backTex.GetAddressOf()); // Accesses one of the buffers of the back buffer chain
+	res = device->CreateRenderTargetView(backTex.Get(), nullptr, rtv.GetAddressOf());
+
+	// Compiled shaders are kept in "./ShaderCache" between runs
+	CreateDirectoryA("./ShaderCache", nullptr);
+	auto shaderCache = std::make_shared<ShaderCache>(Platform::CreateShaderCompiler(), "./ShaderCache");
+	shaderLibrary = std::make_shared<ShaderLibrary>(device, shaderCache);
+	meshRegistry = std::make_shared<MeshRegistry>(device);
+	stateCache = std::make_shared<D3D11StateCache>(device);
+	stateFilter = std::make_shared<StateFilteredContext>(context);
+
+	constantRing = std::make_shared<D3D11ConstantRing>();
+	if (!constantRing->Initialize(device, context))
+		constantRing = nullptr;
+
+	spriteRendererFailed = false;
+}
+
+/*
+* Prepare next frame
+* Clear states and render targets
+*/
+void D3D11GraphicsBackend::PrepareFrame() {
+	context->ClearState(); // Reset parameters to default
+
+	context->OMSetRenderTargets(1, rtv.GetAddressOf(), nullptr);
+
+	context->RSSetViewports(1, viewport.get());
+	float backgroundColor[] = { 0.18f, 0.55f, 0.34f, 1.0f };
+	context->ClearRenderTargetView(rtv.Get(), backgroundColor);
+
+	// ClearState() unbound everything
+	stateFilter->Invalidate();
+}
+
+/*
+* Presenting graphics
+* Without vsync Present() returns at once unless the flip queue is full
+*/
+void D3D11GraphicsBackend::EndFrame() {
+	context->OMSetRenderTargets(0, nullptr, nullptr);
+
+	swapChain->Present(vsync ? 1 : 0, 0); // Show what we've drawn
+}
+
+void D3D11GraphicsBackend::SetVSync(bool vsync) {
+	this->vsync = vsync;
+}
+
+void D3D11GraphicsBackend::DestroyResources() {
+	if (context)
+		context->ClearState();
+}
+
+/*
+* Compiling pixel and vertex shaders
+* Creating pixel, shader and constant buffers
+* Configure rasterizer for the object
+*/
+std::shared_ptr<RenderMesh> D3D11GraphicsBackend::CreateMesh(const MeshDesc& desc) {
+	auto mesh = std::make_shared<D3D11RenderMesh>();
+
+	// Shaders are shared by all components, compiled once or loaded from the disk cache
+	ShaderDesc vertexShaderDesc = { "./Shaders/MyVeryFirstShader.hlsl", "VSMain", "vs_5_0", {}, ShaderLibrary::GetDefaultFlags() };
+	ShaderDesc pixelShaderDesc = { "./Shaders/MyVeryFirstShader.hlsl", "PSMain", "ps_5_0", {}, ShaderLibrary::GetDefaultFlags() };
+
+	std::string errors;
+	std::shared_ptr<const ShaderBytecode> vertexShaderByteCode; // For the input layout
+	mesh->vertexShaderObject = shaderLibrary->GetVertexShader(vertexShaderDesc, errors, &vertexShaderByteCode);
+	if (mesh->vertexShaderObject)
+		mesh->pixelShaderObject = shaderLibrary->GetPixelShader(pixelShaderDesc, errors);
+
+	if (!mesh->vertexShaderObject || !mesh->pixelShaderObject) {
+		std::cout << errors << std::endl;
+		MessageBoxA(display->GetHWnd(), errors.c_str(), "Shader Error", MB_OK);
+
+		return nullptr;
+	}
+
+	// Input elements are generated by the vertex layout
+	std::vector<D3D11_INPUT_ELEMENT_DESC> inputElements;
+	for (const VertexLayout::InputElement& element : desc.vertexLayout.GetInputElements()) {
+		inputElements.push_back(D3D11_INPUT_ELEMENT_DESC {
+			element.semantic, // HLSL semantic associated with this element in a shader input-signature
+			element.semanticIndex, // Semantic index modifies a semantic, with an integer index number
+			static_cast<DXGI_FORMAT>(element.dxgiFormat), // Data type of the element data
+			0, // Integer value that identifies the input-assembler. Valid values are between 0 and 15
+			element.offset, // Offset (in bytes) from the start of the vertex
+			D3D11_INPUT_PER_VERTEX_DATA, // Identifies the input data class for a single input slot
+			0 // The number of instances to draw using the same per-instance data before advancing in the buffer by one element
+		});
+	}
+
+	// Shared by all components with the same layout and vertex shader
+	mesh->layout = stateCache->GetInputLayout(
+		inputElements.data(),
+		static_cast<UINT>(inputElements.size()),
+		vertexShaderByteCode->data(),
+		vertexShaderByteCode->size()
+	);
+
+	// Position and color pairs are packed into the vertex layout for the GPU
+	std::vector<unsigned char> vertices(desc.vertexCount * desc.vertexLayout.GetStride());
+	VertexPacker::Pack(desc.vertexLayout, desc.vertices, desc.vertexCount, vertices.data());
+
+	// 16-bit when the vertex count allows
+	std::vector<uint16_t> shortIndices;
+	DXGI_FORMAT indexFormat = DXGI_FORMAT_R32_UINT;
+	if (VertexPacker::CanUse16BitIndices(desc.vertexCount)) {
+		shortIndices.resize(desc.indexCount);
+		VertexPacker::PackIndices16(desc.indices, desc.indexCount, shortIndices.data());
+		indexFormat = DXGI_FORMAT_R16_UINT;
+	}
+
+	// Identical geometry of other components is created once
+	mesh->vertexMesh = meshRegistry->GetVertexBuffer(vertices.data(), vertices.size());
+	if (indexFormat == DXGI_FORMAT_R16_UINT)
+		mesh->indexMesh = meshRegistry->GetIndexBuffer(shortIndices.data(), sizeof(uint16_t) * shortIndices.size());
+	else
+		mesh->indexMesh = meshRegistry->GetIndexBuffer(desc.indices, sizeof(int) * desc.indexCount);
+
+	// Own constant buffer of the mesh, the executor updates it when a packet doesn't fit into the constant ring
+	D3D11_BUFFER_DESC constBufDesc = {};
+	constBufDesc.ByteWidth = sizeof(DirectX::SimpleMath::Matrix);
+	constBufDesc.Usage = D3D11_USAGE_DEFAULT;
+	constBufDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	constBufDesc.CPUAccessFlags = 0;
+	constBufDesc.MiscFlags = 0;
+	constBufDesc.StructureByteStride = 0;
+
+	device->CreateBuffer(&constBufDesc, nullptr, mesh->constBuf.GetAddressOf());
+
+	CD3D11_RASTERIZER_DESC rastDesc(D3D11_DEFAULT);
+	rastDesc.CullMode = D3D11_CULL_NONE; // Cull None | Cull Front | Cull Back
+	rastDesc.FillMode = D3D11_FILL_SOLID; // Solid or wireframe
+	rastDesc.DepthClipEnable = FALSE; // As the zeroed descriptor before, D3D11_DEFAULT turns it on
+
+	mesh->rastState = stateCache->GetRasterizerState(rastDesc);
+
+	mesh->vertexShader = mesh->vertexShaderObject.Get();
+	mesh->pixelShader = mesh->pixelShaderObject.Get();
+	mesh->inputLayout = mesh->layout.Get();
+	mesh->rasterizerState = mesh->rastState.Get();
+	mesh->vertexBuffer = mesh->vertexMesh ? mesh->vertexMesh->buffer.Get() : nullptr;
+	mesh->indexBuffer = mesh->indexMesh ? mesh->indexMesh->buffer.Get() : nullptr;
+	mesh->constantBuffer = mesh->constBuf.Get();
+	mesh->vertexStride = desc.vertexLayout.GetStride(); // Position and color in one structure
+	mesh->vertexCount = static_cast<uint32_t>(desc.vertexCount);
+	mesh->indexCount = static_cast<uint32_t>(desc.indexCount);
+	mesh->indexFormat = indexFormat;
+
+	return mesh;
+}
+
+std::shared_ptr<IRenderCommandExecutor> D3D11GraphicsBackend::CreateCommandExecutor() {
+	return std::make_shared<D3D11CommandExecutor>(device, stateFilter, constantRing);
+}
+
+/*
+* The sprite renderer takes the quad index pattern from the first batcher it fills a packet for
+* Called while recording, which may be another thread than the render thread, so only the device is used
+* Without a sprite renderer the packet has no shaders and the executor skips it
+*/
+void D3D11GraphicsBackend::FillSpritePacket(const SpriteBatcher& batcher, DrawPacket& packet) {
+	if (!spriteRenderer && !spriteRendererFailed) {
+		spriteRenderer = std::make_shared<SpriteRenderer>();
+		if (!spriteRenderer->Initialize(device, shaderLibrary, stateCache, batcher)) {
+			spriteRenderer = nullptr;
+			spriteRendererFailed = true;
+		}
+	}
+
+	if (spriteRenderer)
+		spriteRenderer->FillPacket(packet);
+	else
+		packet.indexBuffer = nullptr;
+}
+
+void D3D11GraphicsBackend::PrintStatistics(std::ostream& out) {
+	const ShaderCache::Statistics& shaders = shaderLibrary->GetCache()->GetStatistics();
+	out << "Shader cache: memory hits " << shaders.memoryHits
+		<< ", disk hits " << shaders.diskHits
+		<< ", compiles " << shaders.compiles
+		<< ", failures " << shaders.failures << std::endl;
+
+	const MeshRegistry::Statistics& meshes = meshRegistry->GetStatistics();
+	out << "Mesh registry: requests " << meshes.requests
+		<< ", hits " << meshes.hits
+		<< ", buffers created " << meshes.creations
+		<< ", live " << meshRegistry->GetLiveCount()
+		<< ", bytes created " << meshes.createdBytes
+		<< ", bytes saved " << meshes.savedBytes
+		<< ", collisions " << meshes.collisions << std::endl;
+
+	const LruCacheStatistics& rasterizerStates = stateCache->GetRasterizerStatistics();
+	const LruCacheStatistics& inputLayouts = stateCache->GetInputLayoutStatistics();
+	out << "State cache: rasterizer hits " << rasterizerStates.hits
+		<< ", misses " << rasterizerStates.misses
+		<< ", evictions " << rasterizerStates.evictions
+		<< "; input layout hits " << inputLayouts.hits
+		<< ", misses " << inputLayouts.misses
+		<< ", evictions " << inputLayouts.evictions << std::endl;
+
+	const StateFilteredContext::Statistics& binds = stateFilter->GetStatistics();
+	out << "State filter: issued " << binds.issued
+		<< ", skipped " << binds.skipped << std::endl;
+
+	if (constantRing) {
+		const UploadRing::Statistics& uploads = constantRing->GetRing().GetStatistics();
+		out << "Constant upload ring: last frame " << uploads.lastFrameBytes << " bytes"
+			<< ", mean " << (uploads.frames ? uploads.totalBytes / uploads.frames : 0) << " bytes/frame"
+			<< ", peak " << uploads.peakFrameBytes << " of " << constantRing->GetRing().GetCapacity()
+			<< ", overflows " << uploads.failedAllocations << std::endl;
+	}
+}
+
+Microsoft::WRL::ComPtr<ID3D11Device> D3D11GraphicsBackend::GetDevice() {
+	return device;
+}
+
+Microsoft::WRL::ComPtr<ID3D11DeviceContext> D3D11GraphicsBackend::GetContext() {
+	return context;
+}
+
+Microsoft::WRL::ComPtr<IDXGISwapChain> D3D11GraphicsBackend::GetSwapChain() {
+	return swapChain;
+}
+
+Microsoft::WRL::ComPtr<ID3D11RenderTargetView> D3D11GraphicsBackend::GetRTV() {
+	return rtv;
+}
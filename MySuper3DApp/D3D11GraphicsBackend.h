@@ -0,0 +1,62 @@
+#pragma once
+#include <windows.h>
+#include <wrl.h>
+#include <d3d11.h>
+#include <memory>
+#include "GraphicsBackend.h"
+
+class DisplayWin32;
+class ShaderLibrary;
+class MeshRegistry;
+class D3D11StateCache;
+class StateFilteredContext;
+class D3D11ConstantRing;
+class SpriteRenderer;
+
+/*
+* "Direct3D 11" device and swap chain presenting into a "DisplayWin32" window
+* Owns the shared resources of all meshes: shaders, buffers, states and the constant upload ring
+*/
+class D3D11GraphicsBackend : public GraphicsBackend {
+protected:
+	std::shared_ptr<DisplayWin32> display;
+	std::shared_ptr<D3D11_VIEWPORT> viewport; // Defines the dimensions of a viewport
+	Microsoft::WRL::ComPtr<ID3D11Device> device; // The device interface represents a virtual adapter and it is used to create resources
+	Microsoft::WRL::ComPtr<ID3D11DeviceContext> context; // Interface represents a device context which generates rendering commands
+	std::shared_ptr<DXGI_SWAP_CHAIN_DESC> swapDesc; // Descriptor, that describes swap chain
+	Microsoft::WRL::ComPtr<IDXGISwapChain> swapChain; // Interface implements one or more "IDXGISurface" for storing rendered data before presenting it to an output
+	Microsoft::WRL::ComPtr<ID3D11Texture2D> backTex; // 2D texture interface manages texel data, which is structured memory
+	Microsoft::WRL::ComPtr<ID3D11RenderTargetView> rtv; // Identifies the render-target subresources that can be accessed during rendering (Back buffer?)
+	bool vsync; // Sync interval 1 or 0 for Present()
+
+	std::shared_ptr<ShaderLibrary> shaderLibrary; // Shared shaders
+	std::shared_ptr<MeshRegistry> meshRegistry; // Shared vertex and index buffers
+	std::shared_ptr<D3D11StateCache> stateCache; // Shared rasterizer states and input layouts
+	std::shared_ptr<StateFilteredContext> stateFilter; // Context without redundant binds
+	std::shared_ptr<D3D11ConstantRing> constantRing; // Per-frame constant uploads (nullptr if unsupported)
+	std::shared_ptr<SpriteRenderer> spriteRenderer; // Created by the first FillSpritePacket()
+	bool spriteRendererFailed;
+
+public:
+	HRESULT res; // Used for return codes from "Direct3D 11" functions
+
+	D3D11GraphicsBackend(std::shared_ptr<DisplayWin32> display, bool windowed);
+
+	void PrepareFrame() override;
+	void EndFrame() override;
+	void SetVSync(bool vsync) override;
+	void DestroyResources() override;
+
+	std::shared_ptr<RenderMesh> CreateMesh(const MeshDesc& desc) override;
+	std::shared_ptr<IRenderCommandExecutor> CreateCommandExecutor() override;
+	void FillSpritePacket(const SpriteBatcher& batcher, DrawPacket& packet) override;
+	void PrintStatistics(std::ostream& out) override;
+
+	Microsoft::WRL::ComPtr<ID3D11Device> GetDevice();
+
+	Microsoft::WRL::ComPtr<ID3D11DeviceContext> GetContext();
+
+	Microsoft::WRL::ComPtr<IDXGISwapChain> GetSwapChain();
+
+	Microsoft::WRL::ComPtr<ID3D11RenderTargetView> GetRTV();
+};
@@ -0,0 +1,93 @@
+#include "D3D11StateCache.h"
+#include "Fnv1a.h"
+#include <cstring>
+
+static void AppendBytes(std::vector<unsigned char>& bytes, const void* data, size_t size) {
+	const unsigned char* begin = static_cast<const unsigned char*>(data);
+	bytes.insert(bytes.end(), begin, begin + size);
+}
+
+template<typename T>
+static void AppendValue(std::vector<unsigned char>& bytes, const T& value) {
+	AppendBytes(bytes, &value, sizeof(value));
+}
+
+template<typename T>
+static bool IsSameDescriptor(const T& entry, const std::vector<unsigned char>& descriptor) {
+	return entry.descriptor.size() == descriptor.size() && memcmp(entry.descriptor.data(), descriptor.data(), descriptor.size()) == 0;
+}
+
+const size_t D3D11StateCache::DEFAULT_CAPACITY;
+
+D3D11StateCache::D3D11StateCache(Microsoft::WRL::ComPtr<ID3D11Device> device, size_t capacity) :
+	rasterizerStates(capacity), inputLayouts(capacity) {
+	this->device = device;
+}
+
+/*
+* Fields are serialized one by one: the descriptor may have padding
+*/
+Microsoft::WRL::ComPtr<ID3D11RasterizerState> D3D11StateCache::GetRasterizerState(const D3D11_RASTERIZER_DESC& desc) {
+	std::vector<unsigned char> descriptor;
+	AppendValue(descriptor, desc.FillMode);
+	AppendValue(descriptor, desc.CullMode);
+	AppendValue(descriptor, desc.FrontCounterClockwise);
+	AppendValue(descriptor, desc.DepthBias);
+	AppendValue(descriptor, desc.DepthBiasClamp);
+	AppendValue(descriptor, desc.SlopeScaledDepthBias);
+	AppendValue(descriptor, desc.DepthClipEnable);
+	AppendValue(descriptor, desc.ScissorEnable);
+	AppendValue(descriptor, desc.MultisampleEnable);
+	AppendValue(descriptor, desc.AntialiasedLineEnable);
+	uint64_t key = Fnv1a::Hash(descriptor.data(), descriptor.size());
+
+	// A colliding descriptor counts as a miss
+	Entry<ID3D11RasterizerState>* cached = rasterizerStates.Find(key, [&descriptor](const Entry<ID3D11RasterizerState>& entry) { return IsSameDescriptor(entry, descriptor); });
+	if (cached)
+		return cached->object;
+
+	Entry<ID3D11RasterizerState> entry;
+	if (FAILED(device->CreateRasterizerState(&desc, entry.object.GetAddressOf())))
+		return nullptr;
+	entry.descriptor = std::move(descriptor);
+
+	return rasterizerStates.Insert(key, std::move(entry)).object;
+}
+
+/*
+* Semantic names are serialized by content, the bytecode stands for the input signature
+*/
+Microsoft::WRL::ComPtr<ID3D11InputLayout> D3D11StateCache::GetInputLayout(const D3D11_INPUT_ELEMENT_DESC* elements, UINT elementCount, const void* bytecode, size_t bytecodeSize) {
+	std::vector<unsigned char> descriptor;
+	for (UINT i = 0; i < elementCount; i++) {
+		const D3D11_INPUT_ELEMENT_DESC& element = elements[i];
+		AppendBytes(descriptor, element.SemanticName, strlen(element.SemanticName) + 1);
+		AppendValue(descriptor, element.SemanticIndex);
+		AppendValue(descriptor, element.Format);
+		AppendValue(descriptor, element.InputSlot);
+		AppendValue(descriptor, element.AlignedByteOffset);
+		AppendValue(descriptor, element.InputSlotClass);
+		AppendValue(descriptor, element.InstanceDataStepRate);
+	}
+	AppendBytes(descriptor, bytecode, bytecodeSize);
+	uint64_t key = Fnv1a::Hash(descriptor.data(), descriptor.size());
+
+	Entry<ID3D11InputLayout>* cached = inputLayouts.Find(key, [&descriptor](const Entry<ID3D11InputLayout>& entry) { return IsSameDescriptor(entry, descriptor); });
+	if (cached)
+		return cached->object;
+
+	Entry<ID3D11InputLayout> entry;
+	if (FAILED(device->CreateInputLayout(elements, elementCount, bytecode, bytecodeSize, entry.object.GetAddressOf())))
+		return nullptr;
+	entry.descriptor = std::move(descriptor);
+
+	return inputLayouts.Insert(key, std::move(entry)).object;
+}
+
+const LruCacheStatistics& D3D11StateCache::GetRasterizerStatistics() const {
+	return rasterizerStates.GetStatistics();
+}
+
+const LruCacheStatistics& D3D11StateCache::GetInputLayoutStatistics() const {
+	return inputLayouts.GetStatistics();
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <wrl.h>
+#include <d3d11.h>
+#include <cstdint>
+#include <vector>
+#include "LruCache.h"
+
+/*
+* Shared rasterizer states and input layouts
+* Objects are keyed by a 64-bit hash of their descriptors (and of the vertex shader input
+* signature for layouts), so spawning many objects with the same states creates them once
+* Entries keep the descriptor bytes, a hit is confirmed by comparing them (a colliding descriptor replaces the entry)
+* Entries unused for a long time are evicted (LRU), users keep their own references
+*/
+class D3D11StateCache {
+	template<typename T>
+	struct Entry {
+		Microsoft::WRL::ComPtr<T> object;
+		std::vector<unsigned char> descriptor; // Fields without padding, see GetRasterizerState() and GetInputLayout()
+	};
+
+	Microsoft::WRL::ComPtr<ID3D11Device> device;
+	LruCache<uint64_t, Entry<ID3D11RasterizerState>> rasterizerStates;
+	LruCache<uint64_t, Entry<ID3D11InputLayout>> inputLayouts;
+
+public:
+	static const size_t DEFAULT_CAPACITY = 256; // Entries of every kind
+
+	D3D11StateCache(Microsoft::WRL::ComPtr<ID3D11Device> device, size_t capacity = DEFAULT_CAPACITY);
+
+	// nullptr if the object can't be created
+	Microsoft::WRL::ComPtr<ID3D11RasterizerState> GetRasterizerState(const D3D11_RASTERIZER_DESC& desc);
+	Microsoft::WRL::ComPtr<ID3D11InputLayout> GetInputLayout(const D3D11_INPUT_ELEMENT_DESC* elements, UINT elementCount, const void* bytecode, size_t bytecodeSize);
+
+	const LruCacheStatistics& GetRasterizerStatistics() const;
+	const LruCacheStatistics& GetInputLayoutStatistics() const;
+};
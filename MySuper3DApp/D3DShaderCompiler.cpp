@@ -0,0 +1,41 @@
+#include "D3DShaderCompiler.h"
+#include <wrl.h>
+#include <d3dcompiler.h>
+
+#pragma comment(lib, "d3dcompiler.lib")
+
+bool D3DShaderCompiler::Compile(const std::string& source, const ShaderDesc& desc, ShaderBytecode& bytecode, std::string& errors) {
+	// Macro array ends with a null entry
+	std::vector<D3D_SHADER_MACRO> macros;
+	for (const auto& define : desc.defines)
+		macros.push_back({ define.first.c_str(), define.second.c_str() });
+	macros.push_back({ nullptr, nullptr });
+
+	Microsoft::WRL::ComPtr<ID3DBlob> code;
+	Microsoft::WRL::ComPtr<ID3DBlob> errorCode;
+
+	HRESULT res = D3DCompile(
+		source.data(),
+		source.size(),
+		desc.path.c_str(), // Name for error messages
+		macros.data(),
+		nullptr /*include*/,
+		desc.entryPoint.c_str(),
+		desc.profile.c_str(),
+		desc.flags,
+		0,
+		code.GetAddressOf(),
+		errorCode.GetAddressOf()
+	);
+
+	if (FAILED(res)) {
+		if (errorCode)
+			errors.assign(static_cast<const char*>(errorCode->GetBufferPointer()), errorCode->GetBufferSize());
+		return false;
+	}
+
+	const unsigned char* data = static_cast<const unsigned char*>(code->GetBufferPointer());
+	bytecode.assign(data, data + code->GetBufferSize());
+
+	return true;
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include "ShaderCache.h"
+
+/*
+* "IShaderCompiler" on top of D3DCompile()
+*/
+class D3DShaderCompiler : public IShaderCompiler {
+public:
+	bool Compile(const std::string& source, const ShaderDesc& desc, ShaderBytecode& bytecode, std::string& errors) override;
+};
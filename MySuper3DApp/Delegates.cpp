@@ -1,4 +0,0 @@
-//#include "pch.h"
-#include "Delegates.h"
-
-unsigned int DelegateHandle::CURRENT_ID = 0;
\ No newline at end of file
@@ -28,7 +28,10 @@ Delegates::SetAllocationCallbacks(allocFunction, freeFunc);
 	- Member functions
 	- Lambda's
 	- std::shared_ptr
-- Delegate object is allocated inline if it is under 32 bytes
+- Delegate object is allocated inline if it is under 32 bytes (SizedDelegate<Size, RetVal, Args> sets another size)
+- Copies and moves use the copy/move operations of the bound object, objects of trivially copyable types are copied with memcpy
+- Calls go through a function pointer chosen at bind-time, no virtual calls
+- Functions known at compile time (CreateStatic<&Function>(), CreateRaw<T, &T::Function>(pObject)) are called directly by that pointer
 - Add payload to delegate during bind-time
 - Move operations enable optimization
 
@@ -85,6 +88,11 @@ Raw delegate payload: 10
 #include <vector>
 #include <memory>
 #include <tuple>
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
 
 
 //#include "Exports.h"
@@ -106,7 +114,7 @@ Raw delegate payload: 10
 #endif
 #endif
 
-//The allocation size of delegate data.
+//The default allocation size of delegate data, SizedDelegate selects it per delegate type.
 //Delegates larger than this will be heap allocated.
 #ifndef DELEGATE_INLINE_ALLOCATION_SIZE
 #define DELEGATE_INLINE_ALLOCATION_SIZE 32
@@ -159,6 +167,72 @@ namespace _DelegatesInteral
 		using Type = RetVal(Object::*)(Args...);
 	};
 
+	template<typename... Types>
+	struct AreTriviallyCopyable : std::true_type {};
+
+	template<typename Type, typename... Types>
+	struct AreTriviallyCopyable<Type, Types...> : std::integral_constant<bool, std::is_trivially_copyable<Type>::value && AreTriviallyCopyable<Types...>::value> {};
+
+	//Objects that can be copied and moved with memcpy, without a destructor call on the old address
+	//Delegate objects specialize it by their payload
+	template<typename T>
+	struct IsBitwiseCopyable : std::is_trivially_copyable<T> {};
+
+	//Type-erased copy/move/destroy of the object in an InlineAllocator, recorded when the object is bound
+	struct ObjectOperations
+	{
+		void(*Copy)(void* pDestination, const void* pSource); //nullptr: memcpy
+		void(*Relocate)(void* pDestination, void* pSource); //nullptr: memcpy
+		void(*Destroy)(void* pObject); //nullptr: nothing to do
+		bool IsCopyable;
+	};
+
+	template<typename T>
+	void CopyObject(void* pDestination, const void* pSource)
+	{
+		new (pDestination) T(*static_cast<const T*>(pSource));
+	}
+
+	template<typename T>
+	void RelocateObject(void* pDestination, void* pSource)
+	{
+		new (pDestination) T(std::move(*static_cast<T*>(pSource)));
+		static_cast<T*>(pSource)->~T();
+	}
+
+	template<typename T>
+	void DestroyObject(void* pObject)
+	{
+		static_cast<T*>(pObject)->~T();
+	}
+
+	template<typename T>
+	constexpr void(*GetCopyOperation(std::true_type /*isCopyable*/))(void*, const void*)
+	{
+		return IsBitwiseCopyable<T>::value ? nullptr : &CopyObject<T>;
+	}
+
+	template<typename T>
+	constexpr void(*GetCopyOperation(std::false_type /*isCopyable*/))(void*, const void*)
+	{
+		return nullptr;
+	}
+
+	template<typename T>
+	struct ObjectOperationsFor
+	{
+		static const ObjectOperations Value;
+	};
+
+	template<typename T>
+	const ObjectOperations ObjectOperationsFor<T>::Value =
+	{
+		GetCopyOperation<T>(std::is_copy_constructible<T>()),
+		IsBitwiseCopyable<T>::value ? nullptr : &RelocateObject<T>,
+		std::is_trivially_destructible<T>::value ? nullptr : &DestroyObject<T>,
+		std::is_copy_constructible<T>::value
+	};
+
 	static void* (*Alloc)(size_t size) = [](size_t size) { return malloc(size); };
 	static void(*Free)(void* pPtr) = [](void* pPtr) { free(pPtr); };
 	template<typename T>
@@ -180,27 +254,11 @@ namespace Delegates
 	}
 }
 
-class IDelegateBase
-{
-public:
-	IDelegateBase() = default;
-	virtual ~IDelegateBase() noexcept = default;
-	virtual const void* GetOwner() const { return nullptr; }
-};
-
-//Base type for delegates
-template<typename RetVal, typename... Args>
-class IDelegate : public IDelegateBase
-{
-public:
-	virtual RetVal Execute(Args&&... args) = 0;
-};
-
 template<typename RetVal, typename... Args2>
 class StaticDelegate;
 
 template<typename RetVal, typename... Args, typename... Args2>
-class StaticDelegate<RetVal(Args...), Args2...> : public IDelegate<RetVal, Args...>
+class StaticDelegate<RetVal(Args...), Args2...>
 {
 public:
 	using DelegateFunction = RetVal(*)(Args..., Args2...);
@@ -208,10 +266,14 @@ public:
 	StaticDelegate(DelegateFunction function, Args2&&... args)
 		: m_Function(function), m_Payload(std::forward<Args2>(args)...)
 	{}
-	virtual RetVal Execute(Args&&... args) override
+	RetVal Execute(Args&&... args)
 	{
 		return Execute_Internal(std::forward<Args>(args)..., std::index_sequence_for<Args2...>());
 	}
+	const void* GetOwner() const
+	{
+		return nullptr;
+	}
 private:
 	template<std::size_t... Is>
 	RetVal Execute_Internal(Args&&... args, std::index_sequence<Is...>)
@@ -227,7 +289,7 @@ template<bool IsConst, typename T, typename RetVal, typename... Args2>
 class RawDelegate;
 
 template<bool IsConst, typename T, typename RetVal, typename... Args, typename... Args2>
-class RawDelegate<IsConst, T, RetVal(Args...), Args2...> : public IDelegate<RetVal, Args...>
+class RawDelegate<IsConst, T, RetVal(Args...), Args2...>
 {
 public:
 	using DelegateFunction = typename _DelegatesInteral::MemberFunction<IsConst, T, RetVal, Args..., Args2...>::Type;
@@ -235,11 +297,11 @@ public:
 	RawDelegate(T* pObject, DelegateFunction function, Args2&&... args)
 		: m_pObject(pObject), m_Function(function), m_Payload(std::forward<Args2>(args)...)
 	{}
-	virtual RetVal Execute(Args&&... args) override
+	RetVal Execute(Args&&... args)
 	{
 		return Execute_Internal(std::forward<Args>(args)..., std::index_sequence_for<Args2...>());
 	}
-	virtual const void* GetOwner() const override
+	const void* GetOwner() const
 	{
 		return m_pObject;
 	}
@@ -260,7 +322,7 @@ template<typename TLambda, typename RetVal, typename... Args>
 class LambdaDelegate;
 
 template<typename TLambda, typename RetVal, typename... Args, typename... Args2>
-class LambdaDelegate<TLambda, RetVal(Args...), Args2...> : public IDelegate<RetVal, Args...>
+class LambdaDelegate<TLambda, RetVal(Args...), Args2...>
 {
 public:
 	explicit LambdaDelegate(TLambda&& lambda, Args2&&... args) :
@@ -268,10 +330,14 @@ public:
 		m_Payload(std::forward<Args2>(args)...)
 	{}
 
-	RetVal Execute(Args&&... args) override
+	RetVal Execute(Args&&... args)
 	{
 		return Execute_Internal(std::forward<Args>(args)..., std::index_sequence_for<Args2...>());
 	}
+	const void* GetOwner() const
+	{
+		return nullptr;
+	}
 private:
 	template<std::size_t... Is>
 	RetVal Execute_Internal(Args&&... args, std::index_sequence<Is...>)
@@ -287,7 +353,7 @@ template<bool IsConst, typename T, typename RetVal, typename... Args>
 class SPDelegate;
 
 template<bool IsConst, typename RetVal, typename T, typename... Args, typename... Args2>
-class SPDelegate<IsConst, T, RetVal(Args...), Args2...> : public IDelegate<RetVal, Args...>
+class SPDelegate<IsConst, T, RetVal(Args...), Args2...>
 {
 public:
 	using DelegateFunction = typename _DelegatesInteral::MemberFunction<IsConst, T, RetVal, Args..., Args2...>::Type;
@@ -299,29 +365,27 @@ public:
 	{
 	}
 
-	virtual RetVal Execute(Args&&... args) override
+	RetVal Execute(Args&&... args)
 	{
 		return Execute_Internal(std::forward<Args>(args)..., std::index_sequence_for<Args2...>());
 	}
 
-	virtual const void* GetOwner() const override
+	const void* GetOwner() const
 	{
-		return m_pObject.expired() ? nullptr : m_pObject.lock().get();
+		return m_pObject.lock().get();
 	}
 
 private:
+	//One lock() per call: it both checks for expiry and keeps the object alive during the call
 	template<std::size_t... Is>
 	RetVal Execute_Internal(Args&&... args, std::index_sequence<Is...>)
 	{
-		if (m_pObject.expired())
+		std::shared_ptr<T> pPinned = m_pObject.lock();
+		if (pPinned == nullptr)
 		{
 			return RetVal();
 		}
-		else
-		{
-			std::shared_ptr<T> pPinned = m_pObject.lock();
-			return (pPinned.get()->*m_pFunction)(std::forward<Args>(args)..., std::get<Is>(m_Payload)...);
-		}
+		return (pPinned.get()->*m_pFunction)(std::forward<Args>(args)..., std::get<Is>(m_Payload)...);
 	}
 
 	std::weak_ptr<T> m_pObject;
@@ -329,18 +393,87 @@ private:
 	std::tuple<Args2...> m_Payload;
 };
 
+//Free function known at compile time: nothing is stored and the thunk calls the function directly
+template<typename TFunction, TFunction pFunction, typename Signature>
+class CompileTimeStaticDelegate;
+
+template<typename TFunction, TFunction pFunction, typename RetVal, typename... Args>
+class CompileTimeStaticDelegate<TFunction, pFunction, RetVal(Args...)>
+{
+public:
+	RetVal Execute(Args&&... args)
+	{
+		return pFunction(std::forward<Args>(args)...);
+	}
+	const void* GetOwner() const
+	{
+		return nullptr;
+	}
+};
+
+//Member function known at compile time: only the object is stored
+template<typename T, typename TFunction, TFunction pFunction, typename Signature>
+class CompileTimeRawDelegate;
+
+template<typename T, typename TFunction, TFunction pFunction, typename RetVal, typename... Args>
+class CompileTimeRawDelegate<T, TFunction, pFunction, RetVal(Args...)>
+{
+public:
+	explicit CompileTimeRawDelegate(T* pObject)
+		: m_pObject(pObject)
+	{}
+	RetVal Execute(Args&&... args)
+	{
+		return (m_pObject->*pFunction)(std::forward<Args>(args)...);
+	}
+	const void* GetOwner() const
+	{
+		return m_pObject;
+	}
+
+private:
+	T* m_pObject;
+};
+
+//Delegates that only hold pointers and trivially copyable payload are copied and moved with memcpy
+//(SPDelegate is not, it holds a std::weak_ptr)
+namespace _DelegatesInteral
+{
+	template<typename RetVal, typename... Args, typename... Args2>
+	struct IsBitwiseCopyable<StaticDelegate<RetVal(Args...), Args2...>> : AreTriviallyCopyable<Args2...> {};
+
+	template<bool IsConst, typename T, typename RetVal, typename... Args, typename... Args2>
+	struct IsBitwiseCopyable<RawDelegate<IsConst, T, RetVal(Args...), Args2...>> : AreTriviallyCopyable<Args2...> {};
+
+	template<typename TLambda, typename RetVal, typename... Args, typename... Args2>
+	struct IsBitwiseCopyable<LambdaDelegate<TLambda, RetVal(Args...), Args2...>> : AreTriviallyCopyable<TLambda, Args2...> {};
+
+	//Calls of a bound delegate object go through these thunks instead of virtual functions
+	template<typename T, typename RetVal, typename... Args>
+	RetVal InvokeObject(void* pObject, Args&&... args)
+	{
+		return static_cast<T*>(pObject)->Execute(std::forward<Args>(args)...);
+	}
+
+	template<typename T>
+	const void* GetObjectOwner(const void* pObject)
+	{
+		return static_cast<const T*>(pObject)->GetOwner();
+	}
+}
+
 //A handle to a delegate used for a multicast delegate
-//Static ID so that every handle is unique
+//Index of the slot in the delegate + generation of the slot, so a handle becomes stale when its delegate is removed
 class DelegateHandle
 {
 public:
 	constexpr DelegateHandle() noexcept
-		: m_Id(INVALID_ID)
+		: m_Index(INVALID_INDEX), m_Generation(0)
 	{
 	}
 
-	explicit DelegateHandle(bool /*generateId*/) noexcept
-		: m_Id(GetNewID())
+	constexpr DelegateHandle(unsigned int index, unsigned int generation) noexcept
+		: m_Index(index), m_Generation(generation)
 	{
 	}
 
@@ -349,14 +482,15 @@ public:
 	DelegateHandle& operator=(const DelegateHandle& other) = default;
 
 	DelegateHandle(DelegateHandle&& other) noexcept
-		: m_Id(other.m_Id)
+		: m_Index(other.m_Index), m_Generation(other.m_Generation)
 	{
 		other.Reset();
 	}
 
 	DelegateHandle& operator=(DelegateHandle&& other) noexcept
 	{
-		m_Id = other.m_Id;
+		m_Index = other.m_Index;
+		m_Generation = other.m_Generation;
 		other.Reset();
 		return *this;
 	}
@@ -368,47 +502,50 @@ public:
 
 	bool operator==(const DelegateHandle& other) const noexcept
 	{
-		return m_Id == other.m_Id;
+		return m_Index == other.m_Index && m_Generation == other.m_Generation;
 	}
 
 	bool operator<(const DelegateHandle& other) const noexcept
 	{
-		return m_Id < other.m_Id;
+		return m_Index < other.m_Index || (m_Index == other.m_Index && m_Generation < other.m_Generation);
 	}
 
 	bool IsValid() const noexcept
 	{
-		return m_Id != INVALID_ID;
+		return m_Index != INVALID_INDEX;
 	}
 
 	void Reset() noexcept
 	{
-		m_Id = INVALID_ID;
+		m_Index = INVALID_INDEX;
+		m_Generation = 0;
 	}
 
-	constexpr static const unsigned int INVALID_ID = (unsigned int)~0;
-private:
-	unsigned int m_Id;
-	/*GAMEFRAMEWORK_API*/ static unsigned int CURRENT_ID;
+	unsigned int GetIndex() const noexcept
+	{
+		return m_Index;
+	}
 
-	static int GetNewID()
+	unsigned int GetGeneration() const noexcept
 	{
-		unsigned int output = DelegateHandle::CURRENT_ID++;
-		if (DelegateHandle::CURRENT_ID == INVALID_ID)
-		{
-			DelegateHandle::CURRENT_ID = 0;
-		}
-		return output;
+		return m_Generation;
 	}
+
+	constexpr static const unsigned int INVALID_INDEX = (unsigned int)~0;
+private:
+	unsigned int m_Index;
+	unsigned int m_Generation;
 };
 
+//Storage of one object, inline if it fits into MaxStackSize bytes, otherwise on the heap
+//Copy/move/destroy operations of the object are recorded by Construct(), so copies of the allocator copy the object properly
 template<size_t MaxStackSize>
 class InlineAllocator
 {
 public:
 	//Constructor
 	constexpr InlineAllocator() noexcept
-		: m_Size(0)
+		: m_Size(0), m_pOperations(nullptr)
 	{
 		DELEGATE_STATIC_ASSERT(MaxStackSize > sizeof(void*), "MaxStackSize is smaller or equal to the size of a pointer. This will make the use of an InlineAllocator pointless. Please increase the MaxStackSize.");
 	}
@@ -421,83 +558,63 @@ public:
 
 	//Copy constructor
 	InlineAllocator(const InlineAllocator& other)
-		: m_Size(0)
+		: m_Size(0), m_pOperations(nullptr)
 	{
-		if (other.HasAllocation())
-		{
-			memcpy(Allocate(other.m_Size), other.GetAllocation(), other.m_Size);
-		}
-		m_Size = other.m_Size;
+		CopyFrom(other);
 	}
 
 	//Copy assignment operator
 	InlineAllocator& operator=(const InlineAllocator& other)
 	{
-		if (other.HasAllocation())
+		if (this != &other)
 		{
-			memcpy(Allocate(other.m_Size), other.GetAllocation(), other.m_Size);
+			Free();
+			CopyFrom(other);
 		}
-		m_Size = other.m_Size;
 		return *this;
 	}
 
 	//Move constructor
 	InlineAllocator(InlineAllocator&& other) noexcept
-		: m_Size(other.m_Size)
+		: m_Size(0), m_pOperations(nullptr)
 	{
-		other.m_Size = 0;
-		if (m_Size > MaxStackSize)
-		{
-			std::swap(pPtr, other.pPtr);
-		}
-		else
-		{
-			memcpy(Buffer, other.Buffer, m_Size);
-		}
+		MoveFrom(other);
 	}
 
 	//Move assignment operator
 	InlineAllocator& operator=(InlineAllocator&& other) noexcept
 	{
-		Free();
-		m_Size = other.m_Size;
-		other.m_Size = 0;
-		if (m_Size > MaxStackSize)
+		if (this != &other)
 		{
-			std::swap(pPtr, other.pPtr);
-		}
-		else
-		{
-			memcpy(Buffer, other.Buffer, m_Size);
+			Free();
+			MoveFrom(other);
 		}
 		return *this;
 	}
 
-	//Allocate memory of given size
-	//If the size is over the predefined threshold, it will be allocated on the heap
-	void* Allocate(const size_t size)
+	//Construct an object of type T in place of the current one
+	template<typename T, typename... Args>
+	T* Construct(Args&&... args)
 	{
-		if (m_Size != size)
-		{
-			Free();
-			m_Size = size;
-			if (size > MaxStackSize)
-			{
-				pPtr = _DelegatesInteral::Alloc(size);
-				return pPtr;
-			}
-		}
-		return (void*)Buffer;
+		Free();
+		T* pObject = new (Allocate(sizeof(T))) T(std::forward<Args>(args)...);
+		m_pOperations = &_DelegatesInteral::ObjectOperationsFor<T>::Value;
+		return pObject;
 	}
 
-	//Free the allocated memory
+	//Destroy the object and free the memory
 	void Free()
 	{
+		if (m_pOperations != nullptr && m_pOperations->Destroy != nullptr)
+		{
+			m_pOperations->Destroy(GetAllocation());
+		}
 		if (m_Size > MaxStackSize)
 		{
 			_DelegatesInteral::Free(pPtr);
 		}
 		m_Size = 0;
+		m_pOperations = nullptr;
 	}
 
 	//Return the allocated memory either on the stack or on the heap
@@ -529,56 +646,124 @@ public:
 	}
 
 private:
+	//Allocate memory of given size, the allocator must be empty
+	//If the size is over the predefined threshold, it will be allocated on the heap
+	void* Allocate(const size_t size)
+	{
+		m_Size = size;
+		if (size > MaxStackSize)
+		{
+			pPtr = _DelegatesInteral::Alloc(size);
+			return pPtr;
+		}
+		return (void*)Buffer;
+	}
+
+	void CopyFrom(const InlineAllocator& other)
+	{
+		if (other.HasAllocation() == false)
+		{
+			return;
+		}
+
+		//Objects bound with move-only state can't be copied
+		DELEGATE_ASSERT(other.m_pOperations->IsCopyable, "Bound object is not copyable");
+		if (other.m_pOperations->IsCopyable == false)
+		{
+			return;
+		}
+
+		void* pAlloc = Allocate(other.m_Size);
+		if (other.m_pOperations->Copy != nullptr)
+		{
+			other.m_pOperations->Copy(pAlloc, other.GetAllocation());
+		}
+		else
+		{
+			memcpy(pAlloc, other.GetAllocation(), other.m_Size);
+		}
+		m_pOperations = other.m_pOperations;
+	}
+
+	void MoveFrom(InlineAllocator& other)
+	{
+		if (other.HasAllocation() == false)
+		{
+			return;
+		}
+
+		if (other.HasHeapAllocation())
+		{
+			m_Size = other.m_Size;
+			pPtr = other.pPtr;
+		}
+		else if (other.m_pOperations->Relocate != nullptr)
+		{
+			other.m_pOperations->Relocate(Allocate(other.m_Size), other.Buffer);
+		}
+		else
+		{
+			memcpy(Allocate(other.m_Size), other.Buffer, other.m_Size);
+		}
+		m_pOperations = other.m_pOperations;
+
+		//The object has left "other", nothing to destroy there
+		other.m_Size = 0;
+		other.m_pOperations = nullptr;
+	}
+
 	//If the allocation is smaller than the threshold, Buffer is used
 	//Otherwise pPtr is used together with a separate dynamic allocation
 	union
 	{
-		char Buffer[MaxStackSize];
+		alignas(std::max_align_t) char Buffer[MaxStackSize];
 		void* pPtr;
 	};
 	size_t m_Size;
+	const _DelegatesInteral::ObjectOperations* m_pOperations; //Of the stored object
 };
 
+template<size_t InlineSize>
 class DelegateBase
 {
 public:
 	//Default constructor
 	constexpr DelegateBase() noexcept
-		: m_Allocator()
+		: m_Allocator(), m_pGetOwner(nullptr)
 	{
 	}
 
 	//Default destructor
-	virtual ~DelegateBase() noexcept
+	~DelegateBase() noexcept
 	{
 		Release();
 	}
 
 	//Copy contructor
 	DelegateBase(const DelegateBase& other)
-		: m_Allocator(other.m_Allocator)
+		: m_Allocator(other.m_Allocator), m_pGetOwner(other.m_pGetOwner)
 	{
 	}
 
 	//Copy assignment operator
 	DelegateBase& operator=(const DelegateBase& other)
 	{
-		Release();
 		m_Allocator = other.m_Allocator;
+		m_pGetOwner = other.m_pGetOwner;
 		return *this;
 	}
 
 	//Move constructor
 	DelegateBase(DelegateBase&& other) noexcept
-		: m_Allocator(std::move(other.m_Allocator))
+		: m_Allocator(std::move(other.m_Allocator)), m_pGetOwner(other.m_pGetOwner)
 	{
 	}
 
 	//Move assignment operator
 	DelegateBase& operator=(DelegateBase&& other) noexcept
 	{
-		Release();
 		m_Allocator = std::move(other.m_Allocator);
+		m_pGetOwner = other.m_pGetOwner;
 		return *this;
 	}
 
@@ -589,7 +774,7 @@ public:
 	{
 		if (m_Allocator.HasAllocation())
 		{
-			return GetDelegate()->GetOwner();
+			return m_pGetOwner(m_Allocator.GetAllocation());
 		}
 		return nullptr;
 	}
@@ -627,91 +812,124 @@ public:
 		{
 			return false;
 		}
-		return GetDelegate()->GetOwner() == pObject;
+		return m_pGetOwner(m_Allocator.GetAllocation()) == pObject;
 	}
 
 protected:
 	void Release()
 	{
-		if (m_Allocator.HasAllocation())
-		{
-			GetDelegate()->~IDelegateBase();
-			m_Allocator.Free();
-		}
-	}
-
-	IDelegateBase* GetDelegate() const
-	{
-		return static_cast<IDelegateBase*>(m_Allocator.GetAllocation());
+		m_Allocator.Free();
 	}
 
 	//Allocator for the delegate itself.
-	//Delegate gets allocated when its is smaller or equal than 64 bytes in size.
-	//Can be changed by preference
-	InlineAllocator<DELEGATE_INLINE_ALLOCATION_SIZE> m_Allocator;
+	//Delegate gets allocated inline when it is smaller or equal than InlineSize bytes in size.
+	InlineAllocator<InlineSize> m_Allocator;
+	//Thunk of the bound delegate type, only valid while bound
+	const void* (*m_pGetOwner)(const void* pDelegate);
 };
 
 //Delegate that can be bound to by just ONE object
-template<typename RetVal, typename... Args>
-class Delegate : public DelegateBase
+//Bound objects up to InlineSize bytes are stored without a heap allocation
+//No virtual calls: Execute() calls a thunk of the bound delegate type through a function pointer
+template<size_t InlineSize, typename RetVal, typename... Args>
+class SizedDelegate : public DelegateBase<InlineSize>
 {
 private:
+	using Base = DelegateBase<InlineSize>;
+	using Base::m_Allocator;
+	using Base::m_pGetOwner;
+	using Base::Release;
+
 	template<typename T, typename... Args2>
 	using ConstMemberFunction = typename _DelegatesInteral::MemberFunction<true, T, RetVal, Args..., Args2...>::Type;
 	template<typename T, typename... Args2>
 	using NonConstMemberFunction = typename _DelegatesInteral::MemberFunction<false, T, RetVal, Args..., Args2...>::Type;
 
+	using Invoker = RetVal(*)(void* pDelegate, Args&&... args);
+
 public:
-	using IDelegateT = IDelegate<RetVal, Args...>;
+	using Base::IsBound;
+
+	//Default constructor
+	constexpr SizedDelegate() noexcept
+		: m_pInvoker(nullptr)
+	{
+	}
 
 	//Create delegate using member function
 	template<typename T, typename... Args2>
-	NO_DISCARD static Delegate CreateRaw(T* pObj, NonConstMemberFunction<T, Args2...> pFunction, Args2... args)
+	NO_DISCARD static SizedDelegate CreateRaw(T* pObj, NonConstMemberFunction<T, Args2...> pFunction, Args2... args)
 	{
-		Delegate handler;
+		SizedDelegate handler;
 		handler.Bind<RawDelegate<false, T, RetVal(Args...), Args2...>>(pObj, pFunction, std::forward<Args2>(args)...);
 		return handler;
 	}
 
 	template<typename T, typename... Args2>
-	NO_DISCARD static Delegate CreateRaw(T* pObj, ConstMemberFunction<T, Args2...> pFunction, Args2... args)
+	NO_DISCARD static SizedDelegate CreateRaw(T* pObj, ConstMemberFunction<T, Args2...> pFunction, Args2... args)
 	{
-		Delegate handler;
+		SizedDelegate handler;
 		handler.Bind<RawDelegate<true, T, RetVal(Args...), Args2...>>(pObj, pFunction, std::forward<Args2>(args)...);
 		return handler;
 	}
 
+	//Create delegate using a member function known at compile time: CreateRaw<T, &T::Function>(pObject)
+	template<typename T, NonConstMemberFunction<T> pFunction>
+	NO_DISCARD static SizedDelegate CreateRaw(T* pObj)
+	{
+		SizedDelegate handler;
+		handler.Bind<CompileTimeRawDelegate<T, NonConstMemberFunction<T>, pFunction, RetVal(Args...)>>(pObj);
+		return handler;
+	}
+
+	template<typename T, ConstMemberFunction<T> pFunction>
+	NO_DISCARD static SizedDelegate CreateRaw(T* pObj)
+	{
+		SizedDelegate handler;
+		handler.Bind<CompileTimeRawDelegate<T, ConstMemberFunction<T>, pFunction, RetVal(Args...)>>(pObj);
+		return handler;
+	}
+
 	//Create delegate using global/static function
 	template<typename... Args2>
-	NO_DISCARD static Delegate CreateStatic(RetVal(*pFunction)(Args..., Args2...), Args2... args)
+	NO_DISCARD static SizedDelegate CreateStatic(RetVal(*pFunction)(Args..., Args2...), Args2... args)
 	{
-		Delegate handler;
+		SizedDelegate handler;
 		handler.Bind<StaticDelegate<RetVal(Args...), Args2...>>(pFunction, std::forward<Args2>(args)...);
 		return handler;
 	}
 
+	//Create delegate using a global/static function known at compile time: CreateStatic<&Function>()
+	template<RetVal(*pFunction)(Args...)>
+	NO_DISCARD static SizedDelegate CreateStatic()
+	{
+		SizedDelegate handler;
+		handler.Bind<CompileTimeStaticDelegate<RetVal(*)(Args...), pFunction, RetVal(Args...)>>();
+		return handler;
+	}
+
 	//Create delegate using std::shared_ptr
 	template<typename T, typename... Args2>
-	NO_DISCARD static Delegate CreateSP(const std::shared_ptr<T>& pObject, NonConstMemberFunction<T, Args2...> pFunction, Args2... args)
+	NO_DISCARD static SizedDelegate CreateSP(const std::shared_ptr<T>& pObject, NonConstMemberFunction<T, Args2...> pFunction, Args2... args)
 	{
-		Delegate handler;
+		SizedDelegate handler;
 		handler.Bind<SPDelegate<false, T, RetVal(Args...), Args2...>>(pObject, pFunction, std::forward<Args2>(args)...);
 		return handler;
 	}
 
 	template<typename T, typename... Args2>
-	NO_DISCARD static Delegate CreateSP(const std::shared_ptr<T>& pObject, ConstMemberFunction<T, Args2...> pFunction, Args2... args)
+	NO_DISCARD static SizedDelegate CreateSP(const std::shared_ptr<T>& pObject, ConstMemberFunction<T, Args2...> pFunction, Args2... args)
 	{
-		Delegate handler;
+		SizedDelegate handler;
 		handler.Bind<SPDelegate<true, T, RetVal(Args...), Args2...>>(pObject, pFunction, std::forward<Args2>(args)...);
 		return handler;
 	}
 
 	//Create delegate using a lambda
 	template<typename TLambda, typename... Args2>
-	NO_DISCARD static Delegate CreateLambda(TLambda&& lambda, Args2... args)
+	NO_DISCARD static SizedDelegate CreateLambda(TLambda&& lambda, Args2... args)
 	{
-		Delegate handler;
+		SizedDelegate handler;
 		handler.Bind<LambdaDelegate<TLambda, RetVal(Args...), Args2...>>(std::forward<TLambda>(lambda), std::forward<Args2>(args)...);
 		return handler;
 	}
@@ -730,6 +948,19 @@ public:
 		*this = CreateRaw<T, Args2... >(pObject, pFunction, std::forward<Args2>(args)...);
 	}
 
+	//Bind a member function known at compile time: BindRaw<T, &T::Function>(pObject)
+	template<typename T, NonConstMemberFunction<T> pFunction>
+	void BindRaw(T* pObject)
+	{
+		*this = CreateRaw<T, pFunction>(pObject);
+	}
+
+	template<typename T, ConstMemberFunction<T> pFunction>
+	void BindRaw(T* pObject)
+	{
+		*this = CreateRaw<T, pFunction>(pObject);
+	}
+
 	//Bind a static/global function
 	template<typename... Args2>
 	void BindStatic(RetVal(*pFunction)(Args..., Args2...), Args2&&... args)
@@ -737,6 +968,13 @@ public:
 		*this = CreateStatic<Args2... >(pFunction, std::forward<Args2>(args)...);
 	}
 
+	//Bind a static/global function known at compile time: BindStatic<&Function>()
+	template<RetVal(*pFunction)(Args...)>
+	void BindStatic()
+	{
+		*this = CreateStatic<pFunction>();
+	}
+
 	//Bind a lambda
 	template<typename LambdaType, typename... Args2>
 	void BindLambda(LambdaType&& lambda, Args2&&... args)
@@ -762,14 +1000,14 @@ public:
 	RetVal Execute(Args... args) const
 	{
 		DELEGATE_ASSERT(m_Allocator.HasAllocation(), "Delegate is not bound");
-		return ((IDelegateT*)GetDelegate())->Execute(std::forward<Args>(args)...);
+		return m_pInvoker(m_Allocator.GetAllocation(), std::forward<Args>(args)...);
 	}
 
 	RetVal ExecuteIfBound(Args... args) const
 	{
 		if (IsBound())
 		{
-			return ((IDelegateT*)GetDelegate())->Execute(std::forward<Args>(args)...);
+			return m_pInvoker(m_Allocator.GetAllocation(), std::forward<Args>(args)...);
 		}
 		return RetVal();
 	}
@@ -778,12 +1016,17 @@ private:
 	template<typename T, typename... Args3>
 	void Bind(Args3&&... args)
 	{
-		Release();
-		void* pAlloc = m_Allocator.Allocate(sizeof(T));
-		new (pAlloc) T(std::forward<Args3>(args)...);
+		m_Allocator.template Construct<T>(std::forward<Args3>(args)...);
+		m_pInvoker = &_DelegatesInteral::InvokeObject<T, RetVal, Args...>;
+		m_pGetOwner = &_DelegatesInteral::GetObjectOwner<T>;
 	}
+
+	Invoker m_pInvoker; //Thunk of the bound delegate type, only valid while bound
 };
 
+template<typename RetVal, typename... Args>
+using Delegate = SizedDelegate<DELEGATE_INLINE_ALLOCATION_SIZE, RetVal, Args...>;
+
 
 class MulticastDelegateBase
 {
@@ -792,6 +1035,8 @@ public:
 };
 
 //Delegate that can be bound to by MULTIPLE objects
+//Handlers are kept in a slot map: a dense array of handlers for Broadcast and a slot array that maps handles to it
+//Add, Remove and IsBoundTo are O(1), a removed handle goes stale because the generation of its slot changes
 template<typename... Args>
 class MulticastDelegate : public MulticastDelegateBase
 {
@@ -801,21 +1046,30 @@ public:
 private:
 	struct DelegateHandlerPair
 	{
-		DelegateHandle Handle;
+		DelegateHandle Handle; //Invalid while the handler waits to be erased after a broadcast
 		DelegateT Callback;
-		DelegateHandlerPair() : Handle(false) {}
+		DelegateHandlerPair() {}
 		DelegateHandlerPair(const DelegateHandle& handle, const DelegateT& callback) : Handle(handle), Callback(callback) {}
 		DelegateHandlerPair(const DelegateHandle& handle, DelegateT&& callback) : Handle(handle), Callback(std::move(callback)) {}
 	};
+
+	struct Slot
+	{
+		unsigned int Index; //Position in m_Events or the next free slot
+		unsigned int Generation;
+	};
+
 	template<typename T, typename... Args2>
 	using ConstMemberFunction = typename _DelegatesInteral::MemberFunction<true, T, void, Args..., Args2...>::Type;
 	template<typename T, typename... Args2>
 	using NonConstMemberFunction = typename _DelegatesInteral::MemberFunction<false, T, void, Args..., Args2...>::Type;
 
+	constexpr static const unsigned int NO_FREE_SLOT = (unsigned int)~0;
+
 public:
 	//Default constructor
 	constexpr MulticastDelegate()
-		: m_Locks(0)
+		: m_FirstFreeSlot(NO_FREE_SLOT), m_PendingRemovals(0), m_Locks(0)
 	{
 	}
 
@@ -831,15 +1085,27 @@ public:
 	//Move constructor
 	MulticastDelegate(MulticastDelegate&& other) noexcept
 		: m_Events(std::move(other.m_Events)),
-		m_Locks(std::move(other.m_Locks))
+		m_Slots(std::move(other.m_Slots)),
+		m_FirstFreeSlot(other.m_FirstFreeSlot),
+		m_PendingRemovals(other.m_PendingRemovals),
+		m_Locks(other.m_Locks)
 	{
+		other.m_FirstFreeSlot = NO_FREE_SLOT;
+		other.m_PendingRemovals = 0;
+		other.m_Locks = 0;
 	}
 
 	//Move assignment operator
 	MulticastDelegate& operator=(MulticastDelegate&& other) noexcept
 	{
 		m_Events = std::move(other.m_Events);
-		m_Locks = std::move(other.m_Locks);
+		m_Slots = std::move(other.m_Slots);
+		m_FirstFreeSlot = other.m_FirstFreeSlot;
+		m_PendingRemovals = other.m_PendingRemovals;
+		m_Locks = other.m_Locks;
+		other.m_FirstFreeSlot = NO_FREE_SLOT;
+		other.m_PendingRemovals = 0;
+		other.m_Locks = 0;
 		return *this;
 	}
 
@@ -857,16 +1123,19 @@ public:
 
 	DelegateHandle Add(DelegateT&& handler) noexcept
 	{
-		//Favour an empty space over a possible array reallocation
-		for (size_t i = 0; i < m_Events.size(); ++i)
+		unsigned int slot = m_FirstFreeSlot;
+		if (slot != NO_FREE_SLOT)
 		{
-			if (m_Events[i].Handle.IsValid() == false)
-			{
-				m_Events[i] = DelegateHandlerPair(DelegateHandle(true), std::move(handler));
-				return m_Events[i].Handle;
-			}
+			m_FirstFreeSlot = m_Slots[slot].Index;
+		}
+		else
+		{
+			slot = (unsigned int)m_Slots.size();
+			m_Slots.push_back(Slot{ 0, 0 });
 		}
-		m_Events.emplace_back(DelegateHandle(true), std::move(handler));
+
+		m_Slots[slot].Index = (unsigned int)m_Events.size();
+		m_Events.emplace_back(DelegateHandle(slot, m_Slots[slot].Generation), std::move(handler));
 		return m_Events.back().Handle;
 	}
 
@@ -917,19 +1186,11 @@ public:
 	{
 		if (pObject != nullptr)
 		{
-			for (size_t i = 0; i < m_Events.size(); ++i)
+			for (size_t i = m_Events.size(); i > 0; --i)
 			{
-				if (m_Events[i].Callback.GetOwner() == pObject)
+				if (m_Events[i - 1].Handle.IsValid() && m_Events[i - 1].Callback.GetOwner() == pObject)
 				{
-					if (IsLocked())
-					{
-						m_Events[i].Clear();
-					}
-					else
-					{
-						std::swap(m_Events[i], m_Events[m_Events.size() - 1]);
-						m_Events.pop_back();
-					}
+					RemoveAt(i - 1);
 				}
 			}
 		}
@@ -938,85 +1199,52 @@ public:
 	//Remove a function from the event list by the handle
 	bool Remove(DelegateHandle& handle)
 	{
-		if (handle.IsValid())
+		if (IsBoundTo(handle))
 		{
-			for (size_t i = 0; i < m_Events.size(); ++i)
-			{
-				if (m_Events[i].Handle == handle)
-				{
-					if (IsLocked())
-					{
-						m_Events[i].Callback.Clear();
-					}
-					else
-					{
-						std::swap(m_Events[i], m_Events[m_Events.size() - 1]);
-						m_Events.pop_back();
-					}
-					handle.Reset();
-					return true;
-				}
-			}
+			RemoveAt(m_Slots[handle.GetIndex()].Index);
+			handle.Reset();
+			return true;
 		}
 		return false;
 	}
 
 	bool IsBoundTo(const DelegateHandle& handle) const
 	{
-		if (handle.IsValid())
-		{
-			for (size_t i = 0; i < m_Events.size(); ++i)
-			{
-				if (m_Events[i].Handle == handle)
-				{
-					return true;
-				}
-			}
-		}
-		return false;
+		return handle.IsValid()
+			&& handle.GetIndex() < m_Slots.size()
+			&& m_Slots[handle.GetIndex()].Generation == handle.GetGeneration()
+			&& m_Slots[handle.GetIndex()].Index < m_Events.size()
+			&& m_Events[m_Slots[handle.GetIndex()].Index].Handle == handle;
 	}
 
 	//Remove all the functions bound to the delegate
 	void RemoveAll()
 	{
-		if (IsLocked())
+		for (size_t i = m_Events.size(); i > 0; --i)
 		{
-			for (DelegateHandlerPair& handler : m_Events)
+			if (m_Events[i - 1].Handle.IsValid())
 			{
-				handler.Callback.Clear();
+				RemoveAt(i - 1);
 			}
 		}
-		else
-		{
-			m_Events.clear();
-		}
 	}
 
+	//Release unused memory of the handler array when more than maxSpace elements are unused
 	void Compress(const size_t maxSpace = 0)
 	{
-		if (IsLocked() == false)
+		if (IsLocked() == false && m_Events.capacity() - m_Events.size() > maxSpace)
 		{
-			size_t toDelete = 0;
-			for (size_t i = 0; i < m_Events.size() - toDelete; ++i)
-			{
-				if (m_Events[i].Handle.IsValid() == false)
-				{
-					std::swap(m_Events[i], m_Events[toDelete]);
-					++toDelete;
-				}
-			}
-			if (toDelete > maxSpace)
-			{
-				m_Events.resize(m_Events.size() - toDelete);
-			}
+			m_Events.shrink_to_fit();
 		}
 	}
 
 	//Execute all functions that are bound
+	//Handlers added during the broadcast are called from the next one
 	void Broadcast(Args ...args)
 	{
 		Lock();
-		for (size_t i = 0; i < m_Events.size(); ++i)
+		const size_t count = m_Events.size();
+		for (size_t i = 0; i < count; ++i)
 		{
 			if (m_Events[i].Handle.IsValid())
 			{
@@ -1028,10 +1256,60 @@ public:
 
 	size_t GetSize() const
 	{
-		return m_Events.size();
+		return m_Events.size() - m_PendingRemovals;
 	}
 
 private:
+	//Free the slot of the handler, the handler itself is erased now or after the broadcast
+	void RemoveAt(size_t index)
+	{
+		unsigned int slot = m_Events[index].Handle.GetIndex();
+		//A slot whose generation would wrap is never reused, so old handles can't match it again
+		if (++m_Slots[slot].Generation != 0)
+		{
+			m_Slots[slot].Index = m_FirstFreeSlot;
+			m_FirstFreeSlot = slot;
+		}
+
+		if (IsLocked())
+		{
+			m_Events[index].Handle.Reset();
+			m_Events[index].Callback.Clear();
+			++m_PendingRemovals;
+		}
+		else
+		{
+			Erase(index);
+		}
+	}
+
+	//Move the last handler into the hole
+	void Erase(size_t index)
+	{
+		if (index + 1 != m_Events.size())
+		{
+			m_Events[index] = std::move(m_Events.back());
+			if (m_Events[index].Handle.IsValid())
+			{
+				m_Slots[m_Events[index].Handle.GetIndex()].Index = (unsigned int)index;
+			}
+		}
+		m_Events.pop_back();
+	}
+
+	//Erase handlers removed during the broadcast
+	void ErasePending()
+	{
+		for (size_t i = m_Events.size(); i > 0 && m_PendingRemovals > 0; --i)
+		{
+			if (m_Events[i - 1].Handle.IsValid() == false)
+			{
+				Erase(i - 1);
+				--m_PendingRemovals;
+			}
+		}
+	}
+
 	void Lock()
 	{
 		++m_Locks;
@@ -1042,6 +1320,10 @@ private:
 		//Unlock() should never be called more than Lock()!
 		DELEGATE_ASSERT(m_Locks > 0);
 		--m_Locks;
+		if (m_Locks == 0 && m_PendingRemovals > 0)
+		{
+			ErasePending();
+		}
 	}
 
 	//Returns true is the delegate is currently broadcasting
@@ -1051,7 +1333,10 @@ private:
 		return m_Locks > 0;
 	}
 
-	std::vector<DelegateHandlerPair> m_Events;
+	std::vector<DelegateHandlerPair> m_Events; //Dense, in no particular order
+	std::vector<Slot> m_Slots;
+	unsigned int m_FirstFreeSlot; //Head of the list of free slots
+	unsigned int m_PendingRemovals; //Handlers removed during a broadcast, erased after it
 	unsigned int m_Locks;
 };
 
@@ -1,11 +1,14 @@
 #include "DisplayWin32.h"
+#include "FrameArena.h"
+#include <iostream>
 
-DisplayWin32::DisplayWin32(LPCWSTR& applicationName, int clientWidth, int clientHeight, WNDPROC wndProc) {
+DisplayWin32::DisplayWin32(const std::wstring& applicationName, int clientWidth, int clientHeight, std::shared_ptr<FrameArena> frameArena) {
 	this->applicationName = applicationName;
+	this->frameArena = frameArena;
 	hInstance = GetModuleHandle(nullptr);
 
 	wc.style = CS_HREDRAW | CS_VREDRAW | CS_OWNDC;
-	wc.lpfnWndProc = wndProc;
+	wc.lpfnWndProc = WndProc;
 	wc.cbClsExtra = 0;
 	wc.cbWndExtra = 0;
 	wc.hInstance = hInstance;
@@ -14,7 +17,7 @@ DisplayWin32::DisplayWin32(LPCWSTR& applicationName, int clientWidth, int client
 	wc.hCursor = LoadCursor(nullptr, IDC_ARROW);
 	wc.hbrBackground = static_cast<HBRUSH>(GetStockObject(BLACK_BRUSH));
 	wc.lpszMenuName = nullptr;
-	wc.lpszClassName = applicationName;
+	wc.lpszClassName = this->applicationName.c_str();
 	wc.cbSize = sizeof(WNDCLASSEX);
 
 	// Register the window class.
@@ -39,8 +42,8 @@ DisplayWin32::DisplayWin32(LPCWSTR& applicationName, int clientWidth, int client
 
 	hWnd = CreateWindowEx(
 		WS_EX_APPWINDOW,
-		applicationName,
-		applicationName,
+		this->applicationName.c_str(),
+		this->applicationName.c_str(),
 		dwStyle,
 		posX, posY,
 		windowRect.right - windowRect.left,
@@ -51,10 +54,128 @@ DisplayWin32::DisplayWin32(LPCWSTR& applicationName, int clientWidth, int client
 		nullptr
 	);
 
+	// Messages before this point go to DefWindowProc()
+	SetWindowLongPtr(hWnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
+
 	ShowWindow(hWnd, SW_SHOW);
 	SetForegroundWindow(hWnd);
 	SetFocus(hWnd);
 	ShowCursor(true);
+
+	RAWINPUTDEVICE Rid[2];
+
+	Rid[0].usUsagePage = 0x01;
+	Rid[0].usUsage = 0x02;
+	Rid[0].dwFlags = 0;   // adds HID mouse and also ignores legacy mouse messages
+	Rid[0].hwndTarget = hWnd;
+
+	Rid[1].usUsagePage = 0x01;
+	Rid[1].usUsage = 0x06;
+	Rid[1].dwFlags = 0;   // adds HID keyboard and also ignores legacy keyboard messages
+	Rid[1].hwndTarget = hWnd;
+
+	if (RegisterRawInputDevices(Rid, 2, sizeof(Rid[0])) == FALSE)
+	{
+		auto errorCode = GetLastError();
+		std::cout << "ERROR: " << errorCode << std::endl;
+	}
+}
+
+/*
+* Static method for handling user input
+*/
+LRESULT CALLBACK DisplayWin32::WndProc(HWND hwnd, UINT umessage, WPARAM wparam, LPARAM lparam) {
+	DisplayWin32* display = reinterpret_cast<DisplayWin32*>(GetWindowLongPtr(hwnd, GWLP_USERDATA));
+	if (!display)
+		return DefWindowProc(hwnd, umessage, wparam, lparam);
+
+	return display->MessageHandler(hwnd, umessage, wparam, lparam);
+}
+
+/*
+* Raw input is converted to "RecordedInputEvent" and passed to "InputReceived"
+*/
+LRESULT DisplayWin32::MessageHandler(HWND hwnd, UINT umessage, WPARAM wparam, LPARAM lparam) {
+	switch (umessage) {
+	case WM_INPUT: {
+		UINT dwSize = 0;
+		GetRawInputData(reinterpret_cast<HRAWINPUT>(lparam), RID_INPUT, nullptr, &dwSize, sizeof(RAWINPUTHEADER));
+		// Transient buffer, released with the frame arena, which throws instead of returning nullptr
+		LPBYTE lpb = static_cast<LPBYTE>(frameArena->Allocate(dwSize, alignof(RAWINPUT)));
+
+		if (GetRawInputData((HRAWINPUT)lparam, RID_INPUT, lpb, &dwSize, sizeof(RAWINPUTHEADER)) != dwSize)
+			OutputDebugString(TEXT("GetRawInputData does not return correct size !\n"));
+
+		RAWINPUT* raw = reinterpret_cast<RAWINPUT*>(lpb);
+
+		RecordedInputEvent event = {};
+		if (raw->header.dwType == RIM_TYPEKEYBOARD) {
+			//printf(" Kbd: make=%04i Flags:%04i Reserved:%04i ExtraInformation:%08i, msg=%04i VK=%i \n",
+			//	raw->data.keyboard.MakeCode,
+			//	raw->data.keyboard.Flags,
+			//	raw->data.keyboard.Reserved,
+			//	raw->data.keyboard.ExtraInformation,
+			//	raw->data.keyboard.Message,
+			//	raw->data.keyboard.VKey);
+
+			event.type = RecordedInputEvent::Keyboard;
+			event.makeCode = raw->data.keyboard.MakeCode;
+			event.flags = raw->data.keyboard.Flags;
+			event.vKey = raw->data.keyboard.VKey;
+			event.message = raw->data.keyboard.Message;
+			InputReceived.ExecuteIfBound(event);
+		}
+		else if (raw->header.dwType == RIM_TYPEMOUSE) {
+			//printf(" Mouse: X=%04d Y:%04d \n", raw->data.mouse.lLastX, raw->data.mouse.lLastY);
+			event.type = RecordedInputEvent::Mouse;
+			event.buttonFlags = raw->data.mouse.usButtonFlags;
+			event.wheelDelta = static_cast<short>(raw->data.mouse.usButtonData);
+			event.x = raw->data.mouse.lLastX;
+			event.y = raw->data.mouse.lLastY;
+			InputReceived.ExecuteIfBound(event);
+		}
+
+		return DefWindowProc(hwnd, umessage, wparam, lparam);
+	}
+	default: {
+		return DefWindowProc(hwnd, umessage, wparam, lparam);
+	}
+	}
+}
+
+/*
+* Handle all pending windows messages
+* Returns false after WM_QUIT
+*/
+bool DisplayWin32::ProcessMessages() {
+	MSG msg = {};
+	while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+		if (msg.message == WM_QUIT)
+			return false;
+
+		TranslateMessage(&msg);
+		DispatchMessage(&msg);
+	}
+
+	return true;
+}
+
+void DisplayWin32::RequestExit() {
+	PostQuitMessage(0);
+}
+
+void DisplayWin32::SetTitle(const std::wstring& title) {
+	SetWindowText(hWnd, title.c_str());
+}
+
+bool DisplayWin32::GetCursorPosition(int& x, int& y) {
+	POINT p;
+	if (!GetCursorPos(&p) || !ScreenToClient(hWnd, &p))
+		return false;
+
+	x = p.x;
+	y = p.y;
+	return true;
 }
 
 HWND& DisplayWin32::GetHWnd() {
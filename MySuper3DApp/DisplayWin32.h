@@ -1,22 +1,37 @@
 #pragma once
-#include "Game.h"
+#include <windows.h>
+#include <memory>
+#include <string>
+#include "WindowBackend.h"
 
-class Game;
+class FrameArena;
 
-class DisplayWin32 {
+/*
+* WinApi window with the message pump and raw keyboard and mouse input
+*/
+class DisplayWin32 : public WindowBackend {
 protected:
-	LPCWSTR applicationName;
+	std::wstring applicationName;
 	RECT windowRect;
 	HINSTANCE hInstance;
 	HWND hWnd;
 	WNDCLASSEX wc;
 	int clientWidth;
 	int clientHeight;
+	std::shared_ptr<FrameArena> frameArena; // Transient WM_INPUT buffers
+
+	static LRESULT CALLBACK WndProc(HWND hwnd, UINT umessage, WPARAM wparam, LPARAM lparam);
+	LRESULT MessageHandler(HWND hwnd, UINT umessage, WPARAM wparam, LPARAM lparam);
 
 public:
-	DisplayWin32(LPCWSTR& applicationName, int clientWidth, int clientHeight, WNDPROC wndProc);
+	DisplayWin32(const std::wstring& applicationName, int clientWidth, int clientHeight, std::shared_ptr<FrameArena> frameArena);
+
+	bool ProcessMessages() override;
+	void RequestExit() override;
+	void SetTitle(const std::wstring& title) override;
 
-	int GetClientWidth();
-	int GetClientHeight();
+	int GetClientWidth() override;
+	int GetClientHeight() override;
+	bool GetCursorPosition(int& x, int& y) override;
 	HWND& GetHWnd();
 };
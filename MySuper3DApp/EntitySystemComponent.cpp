@@ -0,0 +1,39 @@
+#include "EntitySystemComponent.h"
+
+EntitySystemComponent::EntitySystemComponent(EntityWorld* world, System update, System fixedUpdate) {
+	this->world = world;
+	this->update = update;
+	this->fixedUpdate = fixedUpdate;
+}
+
+void EntitySystemComponent::Initialize() {
+
+}
+
+/*
+* Run logic system over all matching entities
+*/
+void EntitySystemComponent::Update() {
+	if (update)
+		update(*world);
+}
+
+/*
+* Run physics system over all matching entities
+*/
+void EntitySystemComponent::FixedUpdate() {
+	if (fixedUpdate)
+		fixedUpdate(*world);
+}
+
+void EntitySystemComponent::Draw() {
+
+}
+
+void EntitySystemComponent::Reload() {
+
+}
+
+void EntitySystemComponent::DestroyResources() {
+
+}
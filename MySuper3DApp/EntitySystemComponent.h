@@ -0,0 +1,29 @@
+#pragma once
+#include <functional>
+#include "GameObjectComponent.h"
+#include "EntityWorld.h"
+
+/*
+* Adapter between game objects and the entity world
+* Runs data-oriented systems from the usual GameObject::Update() / FixedUpdate() calls,
+* so game objects and entities can live in one scene
+*/
+class EntitySystemComponent : public GameObjectComponent {
+public:
+	using System = std::function<void(EntityWorld& world)>;
+
+protected:
+	EntityWorld* world;
+	System update;
+	System fixedUpdate;
+
+public:
+	EntitySystemComponent(EntityWorld* world, System update, System fixedUpdate = nullptr);
+
+	void Initialize();
+	void Update();
+	void FixedUpdate();
+	void Draw();
+	void Reload();
+	void DestroyResources();
+};
@@ -0,0 +1,188 @@
+#include "EntityWorld.h"
+#include <algorithm>
+#include <cassert>
+
+std::atomic<uint32_t> ComponentType::nextId(0);
+size_t ComponentType::sizes[ComponentType::MAX_TYPES];
+size_t ComponentType::alignments[ComponentType::MAX_TYPES];
+
+uint32_t ComponentType::Register(size_t size, size_t alignment) {
+	uint32_t id = nextId++;
+	assert(id < MAX_TYPES && "Too many entity component types");
+
+	sizes[id] = size;
+	alignments[id] = alignment;
+	return id;
+}
+
+/*
+* Lay out one column per component type inside a chunk
+*/
+Archetype::Archetype(ComponentMask mask) {
+	this->mask = mask;
+	entityCount = 0;
+
+	size_t rowSize = 0;
+	for (uint32_t type = 0; type < ComponentType::MAX_TYPES; type++) {
+		if (mask & (ComponentMask(1) << type)) {
+			types.push_back(type);
+			rowSize += ComponentType::sizes[type];
+		}
+	}
+
+	chunkCapacity = rowSize > 0 ? std::max<size_t>(1, CHUNK_SIZE / rowSize) : CHUNK_SIZE;
+
+	// Columns can't cross because of alignment padding, so leave a bit less rows
+	columnOffsets.resize(ComponentType::MAX_TYPES, 0);
+	while (true) {
+		size_t offset = 0;
+		for (uint32_t type : types) {
+			size_t alignment = ComponentType::alignments[type];
+			offset = (offset + alignment - 1) / alignment * alignment;
+			columnOffsets[type] = offset;
+			offset += ComponentType::sizes[type] * chunkCapacity;
+		}
+
+		if (offset <= CHUNK_SIZE || chunkCapacity == 1) {
+			chunkBytes = offset;
+			break;
+		}
+		chunkCapacity--;
+	}
+}
+
+void Archetype::Allocate(EntityId entity, size_t& chunk, size_t& row) {
+	if (chunks.empty() || chunks.back().count == chunkCapacity) {
+		const size_t cacheLine = 64;
+
+		Chunk newChunk;
+		newChunk.storage.reset(new unsigned char[chunkBytes + cacheLine]);
+		uintptr_t address = reinterpret_cast<uintptr_t>(newChunk.storage.get());
+		newChunk.data = reinterpret_cast<unsigned char*>((address + cacheLine - 1) / cacheLine * cacheLine);
+		newChunk.entities.resize(chunkCapacity);
+		newChunk.count = 0;
+
+		chunks.push_back(std::move(newChunk));
+	}
+
+	chunk = chunks.size() - 1;
+	row = chunks.back().count++;
+	chunks[chunk].entities[row] = entity;
+	entityCount++;
+}
+
+/*
+* Fill the hole with the last entity of the archetype, so the chunks stay dense
+*/
+EntityId Archetype::Remove(size_t chunk, size_t row) {
+	size_t lastChunk = chunks.size() - 1;
+	size_t lastRow = chunks[lastChunk].count - 1;
+	EntityId moved;
+
+	if (chunk != lastChunk || row != lastRow) {
+		for (uint32_t type : types)
+			memcpy(GetComponent(chunk, row, type), GetComponent(lastChunk, lastRow, type), ComponentType::sizes[type]);
+
+		moved = chunks[lastChunk].entities[lastRow];
+		chunks[chunk].entities[row] = moved;
+	}
+
+	chunks[lastChunk].count--;
+	if (chunks[lastChunk].count == 0)
+		chunks.pop_back();
+
+	entityCount--;
+	return moved;
+}
+
+EntityWorld::EntityWorld() {
+	entityCount = 0;
+}
+
+Archetype* EntityWorld::GetArchetype(ComponentMask mask) {
+	auto found = archetypes.find(mask);
+	if (found != archetypes.end())
+		return found->second.get();
+
+	Archetype* archetype = new Archetype(mask);
+	archetypes[mask].reset(archetype);
+	archetypeList.push_back(archetype);
+	return archetype;
+}
+
+EntityId EntityWorld::CreateEntity(ComponentMask mask) {
+	uint32_t index;
+	if (!freeIndices.empty()) {
+		index = freeIndices.back();
+		freeIndices.pop_back();
+	}
+	else {
+		index = static_cast<uint32_t>(records.size());
+		records.push_back({ nullptr, 0, 0, 0 });
+	}
+
+	EntityRecord& record = records[index];
+	EntityId entity(index, record.generation);
+
+	record.archetype = GetArchetype(mask);
+	record.archetype->Allocate(entity, record.chunk, record.row);
+	entityCount++;
+
+	return entity;
+}
+
+void EntityWorld::Destroy(EntityId entity) {
+	if (!IsAlive(entity))
+		return;
+
+	EntityRecord& record = records[entity.index];
+	EntityId moved = record.archetype->Remove(record.chunk, record.row);
+	if (moved.IsValid()) {
+		records[moved.index].chunk = record.chunk;
+		records[moved.index].row = record.row;
+	}
+
+	record.archetype = nullptr;
+	record.generation++;
+	freeIndices.push_back(entity.index);
+	entityCount--;
+}
+
+bool EntityWorld::IsAlive(EntityId entity) const {
+	return entity.index < records.size()
+		&& records[entity.index].generation == entity.generation
+		&& records[entity.index].archetype != nullptr;
+}
+
+/*
+* Copy components that exist in both archetypes, then free the old row
+*/
+void EntityWorld::MoveEntity(EntityId entity, ComponentMask mask) {
+	EntityRecord& record = records[entity.index];
+	Archetype* oldArchetype = record.archetype;
+	Archetype* newArchetype = GetArchetype(mask);
+	if (oldArchetype == newArchetype)
+		return;
+
+	size_t chunk, row;
+	newArchetype->Allocate(entity, chunk, row);
+
+	for (uint32_t type : oldArchetype->GetTypes())
+		if (newArchetype->HasType(type))
+			memcpy(newArchetype->GetComponent(chunk, row, type), oldArchetype->GetComponent(record.chunk, record.row, type), ComponentType::sizes[type]);
+
+	EntityId moved = oldArchetype->Remove(record.chunk, record.row);
+	if (moved.IsValid()) {
+		records[moved.index].chunk = record.chunk;
+		records[moved.index].row = record.row;
+	}
+
+	record.archetype = newArchetype;
+	record.chunk = chunk;
+	record.row = row;
+}
+
+void* EntityWorld::GetComponent(EntityId entity, uint32_t type) {
+	EntityRecord& record = records[entity.index];
+	return record.archetype->GetComponent(record.chunk, record.row, type);
+}
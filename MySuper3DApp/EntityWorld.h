@@ -0,0 +1,218 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/*
+* Handle of an entity
+* Generation changes when the slot is reused, so old handles become invalid
+*/
+struct EntityId {
+	uint32_t index;
+	uint32_t generation;
+
+	static const uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+	EntityId() : index(INVALID_INDEX), generation(0) {}
+	EntityId(uint32_t index, uint32_t generation) : index(index), generation(generation) {}
+
+	bool IsValid() const { return index != INVALID_INDEX; }
+	bool operator==(const EntityId& other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const EntityId& other) const { return !(*this == other); }
+};
+
+using ComponentMask = uint64_t; // One bit per component type, so at most 64 types
+
+/*
+* Runtime id of a component type
+*/
+class ComponentType {
+	static std::atomic<uint32_t> nextId; // Types may be registered from worker threads first
+
+	static uint32_t Register(size_t size, size_t alignment);
+
+public:
+	static const uint32_t MAX_TYPES = 64;
+
+	static size_t sizes[MAX_TYPES];
+	static size_t alignments[MAX_TYPES];
+
+	template<typename T>
+	static uint32_t Id() {
+		static_assert(std::is_trivially_copyable<T>::value, "Entity components must be trivially copyable");
+		static const uint32_t id = Register(sizeof(T), alignof(T));
+		return id;
+	}
+
+	template<typename T>
+	static ComponentMask Mask() {
+		return ComponentMask(1) << Id<T>();
+	}
+};
+
+/*
+* All entities with the same set of components
+* Entities are stored in fixed size chunks, every chunk keeps one dense array per component (SoA)
+*/
+class Archetype {
+public:
+	static const size_t CHUNK_SIZE = 16 * 1024; // Bytes of component data per chunk
+
+	struct Chunk {
+		std::unique_ptr<unsigned char[]> storage;
+		unsigned char* data; // "storage" aligned to a cache line
+		std::vector<EntityId> entities;
+		size_t count;
+	};
+
+private:
+	ComponentMask mask;
+	std::vector<uint32_t> types; // Sorted component type ids
+	std::vector<size_t> columnOffsets; // Offset of every column inside chunk data (indexed by type id)
+	size_t chunkCapacity; // Entities per chunk
+	size_t chunkBytes;
+	std::vector<Chunk> chunks;
+	size_t entityCount;
+
+public:
+	Archetype(ComponentMask mask);
+
+	ComponentMask GetMask() const { return mask; }
+	const std::vector<uint32_t>& GetTypes() const { return types; }
+	size_t GetChunkCapacity() const { return chunkCapacity; }
+	size_t GetEntityCount() const { return entityCount; }
+	std::vector<Chunk>& GetChunks() { return chunks; }
+
+	bool HasType(uint32_t type) const { return (mask & (ComponentMask(1) << type)) != 0; }
+
+	void* GetColumn(Chunk& chunk, uint32_t type) const { return chunk.data + columnOffsets[type]; }
+
+	void* GetComponent(size_t chunk, size_t row, uint32_t type) {
+		return static_cast<unsigned char*>(GetColumn(chunks[chunk], type)) + row * ComponentType::sizes[type];
+	}
+
+	void Allocate(EntityId entity, size_t& chunk, size_t& row); // Add a row for entity, component data is not initialized
+	EntityId Remove(size_t chunk, size_t row); // Returns entity moved into the hole or invalid id
+};
+
+/*
+* Archetype based entity-component store
+* Components are plain data, systems iterate dense per-chunk arrays with Each() and EachChunk()
+*/
+class EntityWorld {
+	struct EntityRecord {
+		Archetype* archetype;
+		size_t chunk;
+		size_t row;
+		uint32_t generation;
+	};
+
+	std::unordered_map<ComponentMask, std::unique_ptr<Archetype>> archetypes;
+	std::vector<Archetype*> archetypeList; // Same archetypes for fast iteration
+	std::vector<EntityRecord> records;
+	std::vector<uint32_t> freeIndices;
+	size_t entityCount;
+
+	Archetype* GetArchetype(ComponentMask mask);
+	EntityId CreateEntity(ComponentMask mask);
+	void MoveEntity(EntityId entity, ComponentMask mask);
+	void* GetComponent(EntityId entity, uint32_t type);
+
+	void SetComponents(EntityId) {} // Entity without components
+
+	template<typename T>
+	void SetComponents(EntityId entity, const T& value) {
+		*static_cast<T*>(GetComponent(entity, ComponentType::Id<T>())) = value;
+	}
+
+	template<typename T, typename T2, typename... Ts>
+	void SetComponents(EntityId entity, const T& value, const T2& value2, const Ts&... values) {
+		SetComponents(entity, value);
+		SetComponents(entity, value2, values...);
+	}
+
+	template<typename... Ts>
+	static ComponentMask MaskOf() {
+		ComponentMask mask = 0;
+		int expand[] = { 0, (mask |= ComponentType::Mask<Ts>(), 0)... };
+		(void)expand;
+		return mask;
+	}
+
+public:
+	EntityWorld();
+
+	EntityWorld(const EntityWorld&) = delete;
+	EntityWorld& operator=(const EntityWorld&) = delete;
+
+	// Create entity with given component values
+	template<typename... Ts>
+	EntityId Create(const Ts&... values) {
+		EntityId entity = CreateEntity(MaskOf<Ts...>());
+		SetComponents(entity, values...);
+		return entity;
+	}
+
+	void Destroy(EntityId entity);
+	bool IsAlive(EntityId entity) const;
+	size_t GetEntityCount() const { return entityCount; }
+	size_t GetArchetypeCount() const { return archetypeList.size(); }
+
+	template<typename T>
+	bool Has(EntityId entity) const {
+		return IsAlive(entity) && records[entity.index].archetype->HasType(ComponentType::Id<T>());
+	}
+
+	// Returns nullptr if there is no such component
+	// Pointer is valid until the next structural change (create, destroy, add, remove)
+	template<typename T>
+	T* Get(EntityId entity) {
+		if (!Has<T>(entity))
+			return nullptr;
+		return static_cast<T*>(GetComponent(entity, ComponentType::Id<T>()));
+	}
+
+	// Moves entity to another archetype
+	template<typename T>
+	void Add(EntityId entity, const T& value) {
+		if (!IsAlive(entity))
+			return;
+		MoveEntity(entity, records[entity.index].archetype->GetMask() | ComponentType::Mask<T>());
+		SetComponents(entity, value);
+	}
+
+	template<typename T>
+	void Remove(EntityId entity) {
+		if (!Has<T>(entity))
+			return;
+		MoveEntity(entity, records[entity.index].archetype->GetMask() & ~ComponentType::Mask<T>());
+	}
+
+	// Call "system(count, Ts* arrays...)" for every chunk whose archetype has all Ts
+	template<typename... Ts, typename System>
+	void EachChunk(System&& system) {
+		ComponentMask mask = MaskOf<Ts...>();
+
+		for (Archetype* archetype : archetypeList) {
+			if ((archetype->GetMask() & mask) != mask)
+				continue;
+
+			for (Archetype::Chunk& chunk : archetype->GetChunks())
+				if (chunk.count > 0)
+					system(chunk.count, static_cast<Ts*>(archetype->GetColumn(chunk, ComponentType::Id<Ts>()))...);
+		}
+	}
+
+	// Call "system(Ts&...)" for every entity that has all Ts
+	template<typename... Ts, typename System>
+	void Each(System&& system) {
+		EachChunk<Ts...>([&system](size_t count, Ts*... arrays) {
+			for (size_t i = 0; i < count; i++)
+				system(arrays[i]...);
+		});
+	}
+};
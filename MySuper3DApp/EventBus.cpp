@@ -0,0 +1,43 @@
+#include "EventBus.h"
+#include "Profiler.h"
+#include <atomic>
+
+static std::atomic<unsigned int> nextQueueIndex(0);
+static std::atomic<uint64_t> nextSequence(1);
+
+/*
+* Threads get queues round-robin in order of their first event
+*/
+unsigned int EventChannelBase::GetQueueIndex() {
+	static thread_local unsigned int queueIndex = nextQueueIndex.fetch_add(1, std::memory_order_relaxed) % MAX_QUEUES;
+	return queueIndex;
+}
+
+uint64_t EventChannelBase::NextSequence() {
+	return nextSequence.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*
+* Pending events of the channel are dropped with it
+*/
+void EventBus::Unregister(const std::shared_ptr<EventChannelBase>& channel) {
+	channels.erase(std::remove(channels.begin(), channels.end(), channel), channels.end());
+}
+
+void EventBus::Dispatch() {
+	PROFILE_SCOPE("EventBus::Dispatch");
+
+	for (const std::shared_ptr<EventChannelBase>& channel : channels)
+		channel->Dispatch();
+}
+
+EventBus::Statistics EventBus::GetStatistics() const {
+	Statistics statistics = { 0, 0 };
+
+	for (const std::shared_ptr<EventChannelBase>& channel : channels) {
+		statistics.enqueued += channel->GetEnqueuedCount();
+		statistics.dispatched += channel->GetDispatchedCount();
+	}
+
+	return statistics;
+}
@@ -0,0 +1,177 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+#include "Delegates.h"
+
+/*
+* How the events of one frame reach the listeners of a channel
+*/
+enum class EventPolicy {
+	KeepAll, // Every event, in order per producing thread
+	CoalesceLatest, // Only the newest event
+	AccumulateDeltas, // All events merged into one by the merge function of the channel
+};
+
+/*
+* Untyped part of an event channel
+* Producers write to the queue of their thread, so threads don't contend on one lock
+*/
+class EventChannelBase {
+protected:
+	static const unsigned int MAX_QUEUES = 16; // Threads beyond this share queues
+
+	static unsigned int GetQueueIndex(); // Queue of the calling thread
+	static uint64_t NextSequence(); // Global order of events
+
+	size_t enqueuedCount; // Events taken by Dispatch() since creation
+	size_t dispatchedCount; // Broadcasts since creation
+
+public:
+	EventChannelBase() : enqueuedCount(0), dispatchedCount(0) {}
+	virtual ~EventChannelBase() = default;
+
+	virtual void Dispatch() = 0;
+
+	size_t GetEnqueuedCount() const { return enqueuedCount; }
+	size_t GetDispatchedCount() const { return dispatchedCount; }
+};
+
+/*
+* Typed events that are delivered once per frame by EventBus::Dispatch()
+* Enqueue() is thread-safe, listeners are called on the thread of Dispatch()
+* Events enqueued by listeners are delivered on the next dispatch
+*/
+template<typename T>
+class EventChannel : public EventChannelBase {
+	static_assert(std::is_trivially_copyable<T>::value, "Events must be plain data");
+
+public:
+	using MergeFunction = void(*)(T& accumulated, const T& event);
+
+private:
+	struct Queue {
+		std::mutex mutex;
+		std::vector<T> events; // KeepAll
+		T latest; // CoalesceLatest and AccumulateDeltas
+		uint64_t sequence; // Of the newest event in "latest"
+		size_t count; // Events since the last dispatch
+	};
+
+	EventPolicy policy;
+	MergeFunction merge;
+	std::unique_ptr<Queue[]> queues;
+	std::vector<T> dispatchEvents; // Events of all queues (KeepAll)
+	std::vector<std::pair<uint64_t, T>> pending; // Newest events of queues, sorted by sequence
+
+public:
+	MulticastDelegate<const T&> Listeners;
+
+	// "merge" is only used by AccumulateDeltas, without it the newest event wins
+	EventChannel(EventPolicy policy, MergeFunction merge = nullptr) : policy(policy), merge(merge), queues(new Queue[MAX_QUEUES]) {
+		for (unsigned int i = 0; i < MAX_QUEUES; i++) {
+			queues[i].sequence = 0;
+			queues[i].count = 0;
+		}
+	}
+
+	EventChannel(const EventChannel&) = delete;
+	EventChannel& operator=(const EventChannel&) = delete;
+
+	EventPolicy GetPolicy() const { return policy; }
+
+	void Enqueue(const T& event) {
+		Queue& queue = queues[GetQueueIndex()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (policy == EventPolicy::KeepAll)
+			queue.events.push_back(event);
+		else {
+			if (queue.count == 0 || policy == EventPolicy::CoalesceLatest || !merge)
+				queue.latest = event;
+			else
+				merge(queue.latest, event);
+
+			queue.sequence = NextSequence();
+		}
+
+		queue.count++;
+	}
+
+	void Dispatch() override {
+		if (policy == EventPolicy::KeepAll) {
+			dispatchEvents.clear();
+			for (unsigned int i = 0; i < MAX_QUEUES; i++) {
+				std::lock_guard<std::mutex> lock(queues[i].mutex);
+				if (queues[i].count == 0)
+					continue;
+
+				dispatchEvents.insert(dispatchEvents.end(), queues[i].events.begin(), queues[i].events.end());
+				queues[i].events.clear();
+				enqueuedCount += queues[i].count;
+				queues[i].count = 0;
+			}
+
+			for (const T& event : dispatchEvents)
+				Listeners.Broadcast(event);
+			dispatchedCount += dispatchEvents.size();
+			return;
+		}
+
+		pending.clear();
+		for (unsigned int i = 0; i < MAX_QUEUES; i++) {
+			std::lock_guard<std::mutex> lock(queues[i].mutex);
+			if (queues[i].count == 0)
+				continue;
+
+			pending.emplace_back(queues[i].sequence, queues[i].latest);
+			enqueuedCount += queues[i].count;
+			queues[i].count = 0;
+		}
+
+		if (pending.empty())
+			return;
+
+		// Older threads first, so the newest event is applied last
+		std::sort(pending.begin(), pending.end(), [](const std::pair<uint64_t, T>& a, const std::pair<uint64_t, T>& b) { return a.first < b.first; });
+
+		T event = pending.back().second;
+		if (policy == EventPolicy::AccumulateDeltas && merge) {
+			event = pending[0].second;
+			for (size_t i = 1; i < pending.size(); i++)
+				merge(event, pending[i].second);
+		}
+
+		Listeners.Broadcast(event);
+		dispatchedCount++;
+	}
+};
+
+/*
+* Frame-scoped event bus
+* Producers enqueue events from any thread, Game dispatches all channels once per frame before Update(),
+* so listeners run once per event that survives the channel policy, not once per raw event
+*/
+class EventBus {
+	std::vector<std::shared_ptr<EventChannelBase>> channels; // Dispatched in order of registration
+
+public:
+	struct Statistics {
+		size_t enqueued; // Events received by all channels
+		size_t dispatched; // Broadcasts to listeners
+	};
+
+	template<typename T>
+	std::shared_ptr<EventChannel<T>> Register(EventPolicy policy, typename EventChannel<T>::MergeFunction merge = nullptr) {
+		auto channel = std::make_shared<EventChannel<T>>(policy, merge);
+		channels.push_back(channel);
+		return channel;
+	}
+
+	void Unregister(const std::shared_ptr<EventChannelBase>& channel); // Main thread only, not from a listener
+	void Dispatch(); // Main thread only
+	Statistics GetStatistics() const;
+};
@@ -0,0 +1,103 @@
+#include "FixedTimestep.h"
+#include <chrono>
+#include <cmath>
+
+FixedTimestep::FixedTimestep(float tickRate, unsigned int maxStepsPerFrame) {
+	this->maxStepsPerFrame = maxStepsPerFrame;
+
+	accumulator = 0;
+	alpha = 0;
+	droppedSteps = 0;
+
+	SetTickRate(tickRate);
+}
+
+void FixedTimestep::SetTickRate(float tickRate) {
+	this->tickRate = tickRate;
+	fixedDeltaTime = 1.0f / tickRate;
+}
+
+void FixedTimestep::SetMaxStepsPerFrame(unsigned int maxStepsPerFrame) {
+	this->maxStepsPerFrame = maxStepsPerFrame;
+}
+
+void FixedTimestep::Reset() {
+	accumulator = 0;
+	alpha = 0;
+	droppedSteps = 0;
+}
+
+/*
+* Add frame time to the accumulator and call "tick" once per whole fixed step
+* If more than "maxStepsPerFrame" steps are pending, the rest of the time is dropped,
+* so one slow frame can't make every following frame even slower
+* Returns number of executed ticks
+*/
+unsigned int FixedTimestep::Advance(float deltaTime, const std::function<void()>& tick) {
+	accumulator += deltaTime;
+
+	unsigned int steps = 0;
+	while (accumulator >= fixedDeltaTime && steps < maxStepsPerFrame) {
+		tick();
+		accumulator -= fixedDeltaTime;
+		steps++;
+	}
+
+	if (accumulator >= fixedDeltaTime) {
+		droppedSteps += static_cast<unsigned int>(accumulator / fixedDeltaTime);
+		accumulator = fmodf(accumulator, fixedDeltaTime);
+	}
+
+	alpha = accumulator / fixedDeltaTime;
+
+	return steps;
+}
+
+float FixedTimestep::GetTickRate() const {
+	return tickRate;
+}
+
+float FixedTimestep::GetFixedDeltaTime() const {
+	return fixedDeltaTime;
+}
+
+unsigned int FixedTimestep::GetMaxStepsPerFrame() const {
+	return maxStepsPerFrame;
+}
+
+float FixedTimestep::GetAlpha() const {
+	return alpha;
+}
+
+unsigned int FixedTimestep::GetDroppedSteps() const {
+	return droppedSteps;
+}
+
+/*
+* Headless tick benchmark
+* Feeds "frames" frames of "frameDeltaTime" seconds into a scheduler without any rendering
+* Measures only the simulation cost
+*/
+FixedTimestep::BenchmarkResult FixedTimestep::Benchmark(const std::function<void()>& tick, float tickRate, unsigned int frames, float frameDeltaTime, unsigned int maxStepsPerFrame) {
+	FixedTimestep scheduler(tickRate, maxStepsPerFrame);
+	BenchmarkResult result = {};
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < frames; i++) {
+		auto frameStart = std::chrono::steady_clock::now();
+		unsigned int steps = scheduler.Advance(frameDeltaTime, tick);
+		float frameTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - frameStart).count();
+
+		result.ticks += steps;
+		if (frameTime > result.worstCatchUpTime) {
+			result.worstCatchUpTime = frameTime;
+			result.worstCatchUpSteps = steps;
+		}
+	}
+
+	float totalTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+	result.ticksPerSecond = totalTime > 0 ? result.ticks / totalTime : 0;
+
+	return result;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <functional>
+
+/*
+* Fixed-step simulation scheduler
+* Accumulates variable frame time and converts it into a whole number of fixed ticks
+*/
+class FixedTimestep {
+public:
+	struct BenchmarkResult {
+		unsigned int ticks; // Total number of executed ticks
+		float ticksPerSecond; // Ticks executed per second of wall-clock time
+		float worstCatchUpTime; // Longest time spent inside one Advance() call (in seconds)
+		unsigned int worstCatchUpSteps; // Number of ticks in that call
+	};
+
+private:
+	float tickRate; // Simulation ticks per second
+	float fixedDeltaTime; // 1 / tickRate
+	unsigned int maxStepsPerFrame; // Cap on catch-up ticks per frame (spiral of death guard)
+	float accumulator; // Not yet simulated time
+	float alpha; // Interpolation factor between the last two ticks [0; 1)
+	unsigned int droppedSteps; // Ticks thrown away because of the cap
+
+public:
+	FixedTimestep(float tickRate = 60.0f, unsigned int maxStepsPerFrame = 5);
+
+	void SetTickRate(float tickRate);
+	void SetMaxStepsPerFrame(unsigned int maxStepsPerFrame);
+	void Reset();
+
+	unsigned int Advance(float deltaTime, const std::function<void()>& tick);
+
+	float GetTickRate() const;
+	float GetFixedDeltaTime() const;
+	unsigned int GetMaxStepsPerFrame() const;
+	float GetAlpha() const;
+	unsigned int GetDroppedSteps() const;
+
+	static BenchmarkResult Benchmark(const std::function<void()>& tick, float tickRate, unsigned int frames, float frameDeltaTime, unsigned int maxStepsPerFrame);
+};
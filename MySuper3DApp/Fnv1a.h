@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*
+* 64-bit FNV-1a hash of cache keys and of the replay state
+* Fields are fed one by one with Add(), starting from OFFSET, so padding of structures is never hashed
+*/
+class Fnv1a {
+public:
+	static const uint64_t OFFSET = 14695981039346656037ull;
+	static const uint64_t PRIME = 1099511628211ull;
+
+	static void Add(uint64_t& hash, const void* data, size_t size) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; i++) {
+			hash ^= bytes[i];
+			hash *= PRIME;
+		}
+	}
+
+	static uint64_t Hash(const void* data, size_t size) {
+		uint64_t hash = OFFSET;
+		Add(hash, data, size);
+		return hash;
+	}
+};
@@ -0,0 +1,88 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+FrameArena::FrameArena(size_t capacity) {
+	this->capacity = capacity;
+
+	for (Buffer& buffer : buffers) {
+		buffer.storage.reset(new unsigned char[capacity + ALIGNMENT]);
+
+		uintptr_t address = reinterpret_cast<uintptr_t>(buffer.storage.get());
+		buffer.data = reinterpret_cast<unsigned char*>((address + ALIGNMENT - 1) & ~(uintptr_t)(ALIGNMENT - 1));
+		buffer.used = 0;
+		buffer.overflowBytes = 0;
+	}
+
+	current = 0;
+	highWaterMark = 0;
+	overflowCount = 0;
+}
+
+FrameArena::~FrameArena() {
+	for (Buffer& buffer : buffers)
+		Reset(buffer);
+}
+
+void FrameArena::Reset(Buffer& buffer) {
+	for (void* block : buffer.overflow)
+		free(block);
+
+	buffer.overflow.clear();
+	buffer.overflowBytes = 0;
+	buffer.used = 0;
+}
+
+/*
+* Call once per frame before any allocation of the frame
+*/
+void FrameArena::BeginFrame() {
+	Buffer& finished = buffers[current];
+	highWaterMark = std::max(highWaterMark, finished.used + finished.overflowBytes);
+
+	current ^= 1;
+	Reset(buffers[current]);
+}
+
+/*
+* Bump allocation, the offset is aligned inside the cache line aligned buffer
+*/
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+	Buffer& buffer = buffers[current];
+
+	size_t offset = (buffer.used + alignment - 1) & ~(alignment - 1);
+	if (offset + size <= capacity) {
+		buffer.used = offset + size;
+		return buffer.data + offset;
+	}
+
+	// Overflow: heap block, aligned by hand, freed with the buffer
+	void* block = malloc(size + alignment - 1);
+	if (!block)
+		throw std::bad_alloc();
+
+	buffer.overflow.push_back(block);
+	buffer.overflowBytes += size;
+	overflowCount++;
+
+	uintptr_t address = reinterpret_cast<uintptr_t>(block);
+	address = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	return reinterpret_cast<void*>(address);
+}
+
+size_t FrameArena::GetCapacity() const {
+	return capacity;
+}
+
+size_t FrameArena::GetUsed() const {
+	return buffers[current].used + buffers[current].overflowBytes;
+}
+
+size_t FrameArena::GetHighWaterMark() const {
+	return std::max(highWaterMark, GetUsed());
+}
+
+size_t FrameArena::GetOverflowCount() const {
+	return overflowCount;
+}
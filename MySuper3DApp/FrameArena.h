@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/*
+* Linear allocator for transient per-frame data
+* Two buffers: memory allocated in frame N stays valid during frame N + 1,
+* so the next frame (or another thread) can still read it
+* Allocation is a pointer bump, free is a no-op, everything is released at once by BeginFrame()
+* When a buffer is full, allocations fall back to the heap and are freed with the buffer
+* Not thread-safe: for the main thread (message handling, frame setup)
+*/
+class FrameArena {
+	struct Buffer {
+		std::unique_ptr<unsigned char[]> storage;
+		unsigned char* data; // "storage" aligned to a cache line
+		size_t used; // Bytes taken by bump allocations
+		std::vector<void*> overflow; // Heap blocks freed on reset
+		size_t overflowBytes;
+	};
+
+	static const size_t ALIGNMENT = 64; // Buffer start alignment (cache line)
+
+	Buffer buffers[2];
+	size_t capacity; // Bytes per buffer
+	unsigned int current; // Index of the buffer of the current frame
+
+	size_t highWaterMark; // Most bytes used by one frame (with overflow)
+	size_t overflowCount; // Heap allocations since creation
+
+	void Reset(Buffer& buffer);
+
+public:
+	FrameArena(size_t capacity = 1024 * 1024);
+	~FrameArena();
+
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	void BeginFrame(); // Switch buffers and release the one used two frames ago
+
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)); // "alignment" is a power of two
+
+	template<typename T>
+	T* AllocateArray(size_t count) {
+		return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+	}
+
+	size_t GetCapacity() const;
+	size_t GetUsed() const; // Bytes used by the current frame
+	size_t GetHighWaterMark() const;
+	size_t GetOverflowCount() const;
+};
+
+/*
+* STL allocator on top of "FrameArena"
+* Containers must not outlive the next frame
+*/
+template<typename T>
+class FrameAllocator {
+public:
+	using value_type = T;
+
+	FrameArena* arena;
+
+	FrameAllocator(FrameArena* arena) : arena(arena) {}
+
+	template<typename U>
+	FrameAllocator(const FrameAllocator<U>& other) : arena(other.arena) {}
+
+	T* allocate(size_t count) {
+		return static_cast<T*>(arena->Allocate(sizeof(T) * count, alignof(T)));
+	}
+
+	void deallocate(T*, size_t) {}
+
+	template<typename U>
+	bool operator==(const FrameAllocator<U>& other) const { return arena == other.arena; }
+
+	template<typename U>
+	bool operator!=(const FrameAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
@@ -0,0 +1,143 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+static const size_t PACING_SAMPLES = 4096;
+static const float MIN_TARGET_FPS = 1.0f;
+static const float MAX_TARGET_FPS = 10000.0f;
+
+FramePacer::FramePacer(PacingMode mode, float targetFps) {
+	this->mode = mode;
+	spinThreshold = std::chrono::microseconds(2000);
+
+	intervals.resize(PACING_SAMPLES);
+	latenesses.resize(PACING_SAMPLES);
+
+	SetTargetFps(targetFps);
+	Reset();
+}
+
+void FramePacer::SetMode(PacingMode mode) {
+	this->mode = mode;
+	Reset();
+}
+
+/*
+* Clamped to [1; 10000], a zero, negative or NaN rate would make an infinite or negative period
+*/
+void FramePacer::SetTargetFps(float targetFps) {
+	if (!(targetFps >= MIN_TARGET_FPS))
+		targetFps = MIN_TARGET_FPS;
+	targetFps = std::min(targetFps, MAX_TARGET_FPS);
+
+	this->targetFps = targetFps;
+	period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps));
+}
+
+void FramePacer::SetSpinThreshold(float seconds) {
+	spinThreshold = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+void FramePacer::Reset() {
+	started = false;
+	sampleIndex = 0;
+}
+
+/*
+* Sleep while the remaining time is longer than "spinThreshold", then spin
+* Sleep alone overshoots by up to a scheduler quantum, spin alone burns a core
+*/
+void FramePacer::Wait(Clock::time_point until) {
+	Clock::time_point now = Clock::now();
+
+	while (until - now > spinThreshold) {
+		std::this_thread::sleep_for(until - now - spinThreshold);
+		now = Clock::now();
+	}
+
+	while (Clock::now() < until)
+		std::this_thread::yield();
+}
+
+/*
+* Start of a frame
+* "TargetFps": frames are scheduled on a fixed grid, a late frame doesn't shift the following ones,
+* but if the frame is more than a whole period late, the grid restarts from now (no burst of catch-up frames)
+* Other modes: the intended start is the actual one, only intervals are measured
+*/
+void FramePacer::BeginFrame() {
+	Clock::time_point previousStart = actualStart;
+
+	if (!started) {
+		started = true;
+		actualStart = Clock::now();
+		intendedStart = actualStart;
+		return;
+	}
+
+	if (mode == PacingMode::TargetFps) {
+		intendedStart += period;
+
+		Clock::time_point now = Clock::now();
+		if (now - intendedStart > period)
+			intendedStart = now;
+		else
+			Wait(intendedStart);
+
+		actualStart = Clock::now();
+	}
+	else {
+		actualStart = Clock::now();
+		intendedStart = actualStart;
+	}
+
+	size_t index = sampleIndex % PACING_SAMPLES;
+	intervals[index] = std::chrono::duration<float>(actualStart - previousStart).count();
+	latenesses[index] = std::chrono::duration<float>(actualStart - intendedStart).count();
+	sampleIndex++;
+}
+
+PacingMode FramePacer::GetMode() const {
+	return mode;
+}
+
+float FramePacer::GetTargetFps() const {
+	return targetFps;
+}
+
+/*
+* Statistics over the last (up to 4096) frames
+*/
+FramePacer::Statistics FramePacer::GetStatistics() const {
+	Statistics statistics = {};
+
+	size_t count = std::min(sampleIndex, PACING_SAMPLES);
+	if (count == 0)
+		return statistics;
+
+	double intervalSum = 0;
+	double latenessSum = 0;
+	for (size_t i = 0; i < count; i++) {
+		intervalSum += intervals[i];
+		latenessSum += latenesses[i];
+	}
+
+	double meanInterval = intervalSum / count;
+	double variance = 0;
+	for (size_t i = 0; i < count; i++)
+		variance += (intervals[i] - meanInterval) * (intervals[i] - meanInterval);
+	variance /= count;
+
+	std::vector<float> sorted(latenesses.begin(), latenesses.begin() + count);
+	std::sort(sorted.begin(), sorted.end());
+
+	statistics.frames = static_cast<unsigned int>(count);
+	statistics.meanInterval = static_cast<float>(meanInterval * 1000.0);
+	statistics.jitter = static_cast<float>(sqrt(variance) * 1000.0);
+	statistics.meanLateness = static_cast<float>(latenessSum / count * 1000.0);
+	statistics.p99Lateness = sorted[static_cast<size_t>(0.99f * (count - 1) + 0.5f)] * 1000.0f;
+	statistics.maxLateness = sorted.back() * 1000.0f;
+
+	return statistics;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <chrono>
+#include <vector>
+
+enum class PacingMode {
+	VSync, // Present waits for the vertical blank
+	Uncapped, // As fast as possible
+	TargetFps // Frame limiter with a hybrid sleep/spin wait
+};
+
+/*
+* Backend independent frame pacing
+* BeginFrame() is called at the start of every frame, in "TargetFps" mode it waits until the intended start
+* Intended and actual start times are recorded for jitter statistics
+*/
+class FramePacer {
+public:
+	struct Statistics {
+		unsigned int frames;
+		float meanInterval; // Mean time between frame starts (in milliseconds)
+		float jitter; // Standard deviation of the interval (in milliseconds)
+		float meanLateness; // Actual minus intended start time (in milliseconds)
+		float p99Lateness;
+		float maxLateness;
+	};
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	PacingMode mode;
+	float targetFps;
+	Clock::duration period; // 1 / targetFps
+	Clock::duration spinThreshold; // The last part of a wait is spun, sleep is too coarse for it
+
+	bool started;
+	Clock::time_point intendedStart; // Intended start of the current frame
+	Clock::time_point actualStart;
+
+	std::vector<float> intervals; // Rings of the last frames (in seconds)
+	std::vector<float> latenesses;
+	size_t sampleIndex;
+
+	void Wait(Clock::time_point until);
+
+public:
+	FramePacer(PacingMode mode = PacingMode::VSync, float targetFps = 60.0f);
+
+	void SetMode(PacingMode mode);
+	void SetTargetFps(float targetFps);
+	void SetSpinThreshold(float seconds);
+	void Reset();
+
+	void BeginFrame();
+
+	PacingMode GetMode() const;
+	float GetTargetFps() const;
+	Statistics GetStatistics() const;
+};
@@ -0,0 +1,144 @@
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+#include <cmath>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define FRUSTUM_CULLER_SSE2
+#endif
+
+using namespace DirectX::SimpleMath;
+
+const size_t FrustumCuller::PLANE_COUNT;
+const size_t FrustumCuller::PARALLEL_THRESHOLD;
+const size_t FrustumCuller::GROUPS_PER_JOB;
+
+FrustumCuller::FrustumCuller() {
+	count = 0;
+	visibleCount = 0;
+
+	SetViewProjection(Matrix::Identity);
+}
+
+/*
+* Gribb-Hartmann: with row vectors clip = v * M, so the planes are sums and differences of columns
+*/
+void FrustumCuller::SetViewProjection(const Matrix& m) {
+	planes[0] = Plane(m._14 + m._11, m._24 + m._21, m._34 + m._31, m._44 + m._41); // Left
+	planes[1] = Plane(m._14 - m._11, m._24 - m._21, m._34 - m._31, m._44 - m._41); // Right
+	planes[2] = Plane(m._14 + m._12, m._24 + m._22, m._34 + m._32, m._44 + m._42); // Bottom
+	planes[3] = Plane(m._14 - m._12, m._24 - m._22, m._34 - m._32, m._44 - m._42); // Top
+	planes[4] = Plane(m._13, m._23, m._33, m._43); // Near
+	planes[5] = Plane(m._14 - m._13, m._24 - m._23, m._34 - m._33, m._44 - m._43); // Far
+
+	for (Plane& plane : planes)
+		plane.Normalize();
+}
+
+void FrustumCuller::Reset() {
+	count = 0;
+	visibleCount = 0;
+}
+
+/*
+* World box of a transformed box: the center is transformed,
+* the extents are transformed by the absolute values of the matrix (Arvo)
+*/
+size_t FrustumCuller::Add(const DirectX::BoundingBox& localBounds, const Matrix& world) {
+	const DirectX::XMFLOAT3& c = localBounds.Center;
+	const DirectX::XMFLOAT3& e = localBounds.Extents;
+
+	size_t index = count++;
+	size_t padded = (count + 3) & ~size_t(3);
+	if (centerX.size() < padded) {
+		centerX.resize(padded);
+		centerY.resize(padded);
+		centerZ.resize(padded);
+		extentX.resize(padded);
+		extentY.resize(padded);
+		extentZ.resize(padded);
+		visible.resize(padded);
+	}
+
+	centerX[index] = c.x * world._11 + c.y * world._21 + c.z * world._31 + world._41;
+	centerY[index] = c.x * world._12 + c.y * world._22 + c.z * world._32 + world._42;
+	centerZ[index] = c.x * world._13 + c.y * world._23 + c.z * world._33 + world._43;
+	extentX[index] = e.x * fabsf(world._11) + e.y * fabsf(world._21) + e.z * fabsf(world._31);
+	extentY[index] = e.x * fabsf(world._12) + e.y * fabsf(world._22) + e.z * fabsf(world._32);
+	extentZ[index] = e.x * fabsf(world._13) + e.y * fabsf(world._23) + e.z * fabsf(world._33);
+
+	return index;
+}
+
+/*
+* A box is outside a plane when dot(n, center) + d < -dot(|n|, extents)
+*/
+void FrustumCuller::CullRange(size_t begin, size_t end) {
+#ifdef FRUSTUM_CULLER_SSE2
+	const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+	for (size_t group = begin; group < end; group++) {
+		size_t i = group * 4;
+		__m128 cx = _mm_loadu_ps(&centerX[i]);
+		__m128 cy = _mm_loadu_ps(&centerY[i]);
+		__m128 cz = _mm_loadu_ps(&centerZ[i]);
+		__m128 ex = _mm_loadu_ps(&extentX[i]);
+		__m128 ey = _mm_loadu_ps(&extentY[i]);
+		__m128 ez = _mm_loadu_ps(&extentZ[i]);
+
+		__m128 outside = _mm_setzero_ps();
+		for (const Plane& plane : planes) {
+			__m128 nx = _mm_set1_ps(plane.x);
+			__m128 ny = _mm_set1_ps(plane.y);
+			__m128 nz = _mm_set1_ps(plane.z);
+
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_add_ps(_mm_mul_ps(nz, cz), _mm_set1_ps(plane.w)));
+			__m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_and_ps(nx, signMask), ex), _mm_mul_ps(_mm_and_ps(ny, signMask), ey)), _mm_mul_ps(_mm_and_ps(nz, signMask), ez));
+
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+		}
+
+		int mask = _mm_movemask_ps(outside);
+		visible[i] = !(mask & 1);
+		visible[i + 1] = !(mask & 2);
+		visible[i + 2] = !(mask & 4);
+		visible[i + 3] = !(mask & 8);
+	}
+#else
+	for (size_t i = begin * 4; i < end * 4; i++) {
+		bool outside = false;
+		for (const Plane& plane : planes) {
+			float distance = plane.x * centerX[i] + plane.y * centerY[i] + plane.z * centerZ[i] + plane.w;
+			float radius = fabsf(plane.x) * extentX[i] + fabsf(plane.y) * extentY[i] + fabsf(plane.z) * extentZ[i];
+			outside = outside || distance + radius < 0;
+		}
+		visible[i] = !outside;
+	}
+#endif
+}
+
+void FrustumCuller::Cull(JobSystem* jobSystem) {
+	size_t groups = (count + 3) / 4;
+
+	if (jobSystem && count >= PARALLEL_THRESHOLD)
+		jobSystem->ParallelFor(groups, GROUPS_PER_JOB, [this](size_t begin, size_t end) {
+			CullRange(begin, end);
+		});
+	else
+		CullRange(0, groups);
+
+	visibleCount = 0;
+	for (size_t i = 0; i < count; i++)
+		visibleCount += visible[i];
+}
+
+bool FrustumCuller::IsVisible(size_t index) const {
+	return visible[index] != 0;
+}
+
+size_t FrustumCuller::GetCount() const {
+	return count;
+}
+
+size_t FrustumCuller::GetVisibleCount() const {
+	return visibleCount;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SimpleMath.h"
+#include "SimpleMath.inl"
+
+class JobSystem;
+
+/*
+* Visibility of axis-aligned boxes against the planes of the view volume
+* World boxes are stored in SoA arrays, the test takes 4 boxes per iteration (SSE)
+* and runs on the job system for large counts
+* A box is culled when it is completely behind one of the planes
+*/
+class FrustumCuller {
+	static const size_t PLANE_COUNT = 6;
+
+	DirectX::SimpleMath::Plane planes[PLANE_COUNT]; // Normals point inside
+
+	// World boxes, padded to a multiple of 4
+	std::vector<float> centerX;
+	std::vector<float> centerY;
+	std::vector<float> centerZ;
+	std::vector<float> extentX;
+	std::vector<float> extentY;
+	std::vector<float> extentZ;
+	std::vector<uint8_t> visible;
+	size_t count;
+	size_t visibleCount;
+
+	void CullRange(size_t begin, size_t end); // Indices of 4-box groups
+
+public:
+	static const size_t PARALLEL_THRESHOLD = 4096; // Fewer boxes are tested on the calling thread
+	static const size_t GROUPS_PER_JOB = 256;
+
+	FrustumCuller();
+
+	// Planes of the clip volume of "viewProjection" (row vectors, D3D depth 0..1)
+	// Identity gives the NDC box the scene is drawn in now
+	void SetViewProjection(const DirectX::SimpleMath::Matrix& viewProjection);
+
+	void Reset();
+	size_t Add(const DirectX::BoundingBox& localBounds, const DirectX::SimpleMath::Matrix& world); // Returns index of the box
+	void Cull(JobSystem* jobSystem); // "jobSystem" may be nullptr
+
+	bool IsVisible(size_t index) const;
+	size_t GetCount() const;
+	size_t GetVisibleCount() const;
+};
@@ -1,155 +1,104 @@
 #include "Game.h"
+#include "Platform.h"
+#include "NullBackend.h"
+#include "SoftwareBackend.h"
+#include "Profiler.h"
+#include "Fnv1a.h"
+#include <cwchar>
 
 Game* Game::instance = nullptr;
 
-/*
-* Static method for handling user input
-*/
-LRESULT CALLBACK WndProc(HWND hwnd, UINT umessage, WPARAM wparam, LPARAM lparam) {
-	return Game::instance->MessageHandler(hwnd, umessage, wparam, lparam);
-}
-
-LRESULT Game::MessageHandler(HWND hwnd, UINT umessage, WPARAM wparam, LPARAM lparam) {
-	switch (umessage) {
-	case WM_INPUT: {
-		UINT dwSize = 0;
-		GetRawInputData(reinterpret_cast<HRAWINPUT>(lparam), RID_INPUT, nullptr, &dwSize, sizeof(RAWINPUTHEADER));
-		LPBYTE lpb = new BYTE[dwSize];
-
-		if (lpb == nullptr) 
-			return 0;
-
-		if (GetRawInputData((HRAWINPUT)lparam, RID_INPUT, lpb, &dwSize, sizeof(RAWINPUTHEADER)) != dwSize)
-			OutputDebugString(TEXT("GetRawInputData does not return correct size !\n"));
-
-		RAWINPUT* raw = reinterpret_cast<RAWINPUT*>(lpb);
+// Sprites go after all meshes, back to front inside a state (see SpriteBatcher)
+static const uint32_t SPRITE_LAYER = 1;
+// Frames of a software run without a frame limit and without replay
+static const unsigned int SOFTWARE_FRAME_LIMIT = 300;
 
-		if (raw->header.dwType == RIM_TYPEKEYBOARD) {
-			//printf(" Kbd: make=%04i Flags:%04i Reserved:%04i ExtraInformation:%08i, msg=%04i VK=%i \n",
-			//	raw->data.keyboard.MakeCode,
-			//	raw->data.keyboard.Flags,
-			//	raw->data.keyboard.Reserved,
-			//	raw->data.keyboard.ExtraInformation,
-			//	raw->data.keyboard.Message,
-			//	raw->data.keyboard.VKey);
-
-			inputDevice.get()->OnKeyDown({
-				raw->data.keyboard.MakeCode,
-				raw->data.keyboard.Flags,
-				raw->data.keyboard.VKey,
-				raw->data.keyboard.Message
-				});
-		}
-		else if (raw->header.dwType == RIM_TYPEMOUSE) {
-			//printf(" Mouse: X=%04d Y:%04d \n", raw->data.mouse.lLastX, raw->data.mouse.lLastY);
-			inputDevice->OnMouseMove({
-				raw->data.mouse.usFlags,
-				raw->data.mouse.usButtonFlags,
-				static_cast<int>(raw->data.mouse.ulExtraInformation),
-				static_cast<int>(raw->data.mouse.ulRawButtons),
-				static_cast<short>(raw->data.mouse.usButtonData),
-				raw->data.mouse.lLastX,
-				raw->data.mouse.lLastY
-				});
-		}
-
-		delete[] lpb;
-		return DefWindowProc(hwnd, umessage, wparam, lparam);
-	}
-	default: {
-		return DefWindowProc(hwnd, umessage, wparam, lparam);
-	}
-	}
-}
-
-Game::Game(LPCWSTR name, int clientWidth, int clientHeight, bool windowed) {
+Game::Game(const std::wstring& name, int clientWidth, int clientHeight, bool windowed) {
 	this->name = name;
 	this->clientWidth = clientWidth;
 	this->clientHeight = clientHeight;
 	this->windowed = windowed;
 
+	headless = false;
+	headlessFrameLimit = 0;
+
 	totalTime = 0;
 	deltaTime = 0;
 	frameCount = 0;
+	fixedTimestep = std::make_shared<FixedTimestep>(60.0f, 5);
+	fixedDeltaTime = fixedTimestep->GetFixedDeltaTime();
+	interpolationAlpha = 0;
+	jobSystem = std::make_shared<JobSystem>();
+	jobGrainSize = 256;
+	splitObjectCount = 0;
+	entities = std::make_shared<EntityWorld>();
+	transforms = std::make_shared<TransformSystem>();
+	frameArena = std::make_shared<FrameArena>(1024 * 1024);
+	eventBus = std::make_shared<EventBus>();
+	framePacer = std::make_shared<FramePacer>(PacingMode::VSync);
+	spriteBatching = true;
+	spriteBatcher = std::make_shared<SpriteBatcher>();
+	recordingSprites = nullptr;
+	commandBuffer = std::make_shared<RenderCommandBuffer>();
+	recordingCommands = nullptr;
+	viewMatrix = DirectX::SimpleMath::Matrix::Identity;
+	culler = std::make_shared<FrustumCuller>();
+	visibleCount = 0;
+	softwareRendering = false;
+	pipelined = false;
+	rendering = false;
+	snapshots = std::make_shared<TripleBuffer<RenderSnapshot>>();
+	publishedSnapshots = 0;
 	startTime = std::make_shared<std::chrono::time_point<std::chrono::steady_clock>>();
 	prevTime = std::make_shared<std::chrono::time_point<std::chrono::steady_clock>>();
-
-	viewport = std::make_shared<D3D11_VIEWPORT>();
-	swapDesc = std::make_shared<DXGI_SWAP_CHAIN_DESC>();
 }
 
 /*
 * There is no public access to constructor because of "Singleton" pattern
 * Need to use this method to create Game::instance
 */
-void Game::CreateInstance(LPCWSTR name, int screenWidth, int screenHeight, bool windowed) {
+void Game::CreateInstance(const std::wstring& name, int screenWidth, int screenHeight, bool windowed) {
 	if (!instance)
 		instance = new Game(name, screenWidth, screenHeight, windowed);
 }
 
 /*
 * Prepare all "Game" resources
+* Window and GPU backends of the platform or null backends for headless run
+* Platforms without a native backend run headless
 */
 void Game::PrepareResources() {
-	display = std::make_shared<DisplayWin32>(name, clientWidth, clientHeight, WndProc);
-	inputDevice = std::make_shared<InputDevice>();
+	if (!headless) {
+		window = Platform::CreateWindowBackend(name, clientWidth, clientHeight, frameArena);
+		if (window)
+			graphics = Platform::CreateGraphicsBackend(window, windowed);
+
+		if (!window || !graphics) {
+			std::cout << "No window or graphics backend on this platform, running headless" << std::endl;
+			window = nullptr;
+			graphics = nullptr;
+			headless = true;
+		}
+	}
 
-	// Initialize viewport parameters
-	viewport->TopLeftX = 0; // X position of the left hand side of the viewport
-	viewport->TopLeftY = 0; // Y position of the top of the viewport
-	viewport->Width = static_cast<float>(display->GetClientWidth()); // Width of the viewport
-	viewport->Height = static_cast<float>(display->GetClientHeight()); // Height of the viewport
-	viewport->MinDepth = 0; // Minimum depth of the viewport. Ranges between 0 and 1
-	viewport->MaxDepth = 1.0f; // Maximum depth of the viewport. Ranges between 0 and 1
-
-	// BufferDesc describes the backbuffer display mode
-	swapDesc->BufferDesc.Width = display->GetClientWidth(); // Resolution width
-	swapDesc->BufferDesc.Height = display->GetClientHeight(); // Resolution height
-	swapDesc->BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; // Display format (32-bit unsigned normalized integer format supporting 8 bits per channel, including the alpha channel)
-	swapDesc->BufferDesc.RefreshRate.Numerator = 60; // Refresh rate in hertz numerator
-	swapDesc->BufferDesc.RefreshRate.Denominator = 1; // Refresh rate in hertz denominator (for representing integer it = 1)
-	swapDesc->BufferDesc.ScanlineOrdering = DXGI_MODE_SCANLINE_ORDER_UNSPECIFIED; // Scanline drawing mode (indicating the method the raster uses to create an image on a surface)
-	swapDesc->BufferDesc.Scaling = DXGI_MODE_SCALING_UNSPECIFIED; // Scaling mode (indicating how an image is stretched to fit a given monitor's resolution)
-
-	/* 
-	* SampleDesc describes multi - sampling parameters for a resource
-	* The default sampler mode, with no anti-aliasing, has a count of 1 and a quality level of 0
-	*/
-	swapDesc->SampleDesc.Count = 1; // Number of multisamples per pixel
-	swapDesc->SampleDesc.Quality = 0; // The image quality level. The higher the quality, the lower the performance
-
-	swapDesc->BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT; // Describes the surface usage and CPU access options for the back buffer
-	swapDesc->BufferCount = 2; // Number of buffers in the swap chain (double or triple buffering)
-	swapDesc->OutputWindow = display->GetHWnd(); // Handle to the output window. This member must not be NULL.
-	swapDesc->Windowed = windowed;
-	swapDesc->SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD; // Describes options for handling the contents of the presentation buffer after presenting a surface
-	swapDesc->Flags = DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH; // Options for swap-chain behavior
-
-	const int featureLevelsNumber = 1;
-	D3D_FEATURE_LEVEL featureLevels[featureLevelsNumber] = { D3D_FEATURE_LEVEL_11_1 };
-
-	// Creates a device that represents the display adapter and a swap chain used for rendering
-	res = D3D11CreateDeviceAndSwapChain(
-		nullptr,
-		D3D_DRIVER_TYPE_HARDWARE,
-		nullptr,
-		D3D11_CREATE_DEVICE_DEBUG,
-		featureLevels, // Determine the order of feature levels to attempt to create
-		featureLevelsNumber, // The number of elements in feature levels array
-		D3D11_SDK_VERSION,
-		swapDesc.get(),
-		swapChain.GetAddressOf(),
-		device.GetAddressOf(),
-		nullptr, // Feature level for device
-		context.GetAddressOf()
-	);
+	if (headless) {
+		// Resolved here so the order of SetSoftwareRendering(), SetHeadless() and SetReplay() doesn't matter
+		if (softwareRendering && headlessFrameLimit == 0 && !inputReplayer)
+			headlessFrameLimit = SOFTWARE_FRAME_LIMIT;
+
+		window = std::make_shared<NullWindow>(clientWidth, clientHeight, headlessFrameLimit);
 
-	if (FAILED(res)) {
-		// Well, that was unexpected
+		if (softwareRendering) {
+			software = std::make_shared<SoftwareGraphics>(clientWidth, clientHeight, jobSystem.get(), softwareFramePath);
+			graphics = software;
+		}
+		else
+			graphics = std::make_shared<NullGraphics>();
 	}
-	
-	res = swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)backTex.GetAddressOf()); // Accesses one of the buffers of the back buffer chain
-	res = device->CreateRenderTargetView(backTex.Get(), nullptr, rtv.GetAddressOf());
+
+	window->InputReceived.BindRaw(this, &Game::OnInputReceived);
+
+	inputDevice = std::make_shared<InputDevice>();
 }
 
 /*
@@ -158,50 +107,181 @@ void Game::PrepareResources() {
 void Game::Initialize() {
 	for (auto component : gameObjects)
 		component->Initialize();
+
+	SplitGameObjects();
+
+	// Headless runs count the commands instead
+	commandExecutor = graphics->CreateCommandExecutor();
 }
 
 /*
 * Prepare next frame
-* Clear states and render targets
 */
 void Game::PrepareFrame() {
-	context->ClearState(); // Reset parameters to default
+	PROFILE_SCOPE("Game::PrepareFrame");
 
-	context->OMSetRenderTargets(1, rtv.GetAddressOf(), nullptr);
-
-	context->RSSetViewports(1, viewport.get());
-	float backgroundColor[] = { 0.18f, 0.55f, 0.34f, 1.0f };
-	context->ClearRenderTargetView(rtv.Get(), backgroundColor);
+	graphics->PrepareFrame();
 }
 
 /*
 * Update all "GameComponent" items in vector
 * For logic
+* Concurrent components are updated in parallel first, then the rest on the main thread
 */
 void Game::Update() {
-	for (auto gameObject : gameObjects)
+	PROFILE_SCOPE("Game::Update");
+
+	SplitGameObjects();
+
+	jobSystem->ParallelFor(concurrentObjects.size(), jobGrainSize, [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++)
+			concurrentObjects[i]->UpdateConcurrent();
+	});
+
+	for (auto gameObject : serialObjects)
 		gameObject->Update();
 
 	// Handle ESC button
 	if (inputDevice->IsKeyDown(Keys::Escape))
-		PostQuitMessage(0);
+		window->RequestExit();
 }
 
 /*
 * FixedUpdate all "GameComponent" items in vector
 * For physics
+* Called by "fixedTimestep" with a constant "fixedDeltaTime", zero or more times per frame
 */
 void Game::FixedUpdate() {
-	for (auto gameObject : gameObjects)
+	PROFILE_SCOPE("Game::FixedUpdate");
+
+	SplitGameObjects();
+
+	jobSystem->ParallelFor(concurrentObjects.size(), jobGrainSize, [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++)
+			concurrentObjects[i]->FixedUpdateConcurrent();
+	});
+
+	for (auto gameObject : serialObjects)
 		gameObject->FixedUpdate();
 }
 
+/*
+* Sort game objects into the concurrent and the main thread lists
+* An object with both kinds of components is in both lists
+* Again only when game objects were added or removed
+*/
+void Game::SplitGameObjects() {
+	if (splitObjectCount == gameObjects.size())
+		return;
+
+	concurrentObjects.clear();
+	serialObjects.clear();
+	for (auto gameObject : gameObjects) {
+		if (gameObject->HasConcurrentComponents())
+			concurrentObjects.push_back(gameObject);
+		if (gameObject->HasSerialComponents())
+			serialObjects.push_back(gameObject);
+	}
+
+	splitObjectCount = gameObjects.size();
+}
+
+/*
+* One fixed simulation step
+* World matrices the step starts from are kept, the frame is drawn between them and the result
+*/
+void Game::FixedTick() {
+	transforms->UpdateWorldMatrices();
+	transforms->SavePreviousWorldMatrices();
+
+	FixedUpdate();
+}
+
+/*
+* Build the list of components to draw
+* Components with bounds are culled against the view volume (SIMD, on the job system for large counts),
+* off-screen components are not drawn at all
+*/
+void Game::CullComponents() {
+	PROFILE_SCOPE("Game::CullComponents");
+
+	static const size_t NO_BOUNDS = static_cast<size_t>(-1);
+
+	culler->Reset();
+	drawComponents.clear();
+	cullIndices.clear();
+
+	DirectX::BoundingBox localBounds;
+	DirectX::SimpleMath::Matrix world;
+	for (auto gameObject : gameObjects) {
+		for (auto component : gameObject->components) {
+			drawComponents.push_back(component);
+			cullIndices.push_back(component->GetBounds(localBounds, world) ? culler->Add(localBounds, world) : NO_BOUNDS);
+		}
+	}
+
+	culler->Cull(jobSystem.get());
+
+	// Results go back to the objects in the same order, GameObject::Draw() skips culled components
+	size_t index = 0;
+	visibleCount = 0;
+	for (auto gameObject : gameObjects) {
+		gameObject->visibleComponents.resize(gameObject->components.size());
+		for (size_t i = 0; i < gameObject->components.size(); i++, index++) {
+			bool visible = cullIndices[index] == NO_BOUNDS || culler->IsVisible(cullIndices[index]);
+			gameObject->visibleComponents[i] = visible;
+			if (visible)
+				visibleCount++;
+		}
+	}
+}
+
 /*
 * Draw all "GameComponent" items in vector
+* Components only record: draw packets go to "commands", quads to "sprites", see Submit()
+* Sprite batches become packets of a layer above the meshes, their vertices stay in "sprites"
+* Always on the main thread, also when pipelined, so game objects are never read by the render thread
+* "alpha" shows how far the frame is between the previous and the next fixed tick
 */
-void Game::Draw() {
+void Game::Draw(float alpha, RenderCommandBuffer& commands, SpriteBatcher& sprites) {
+	PROFILE_SCOPE("Game::Draw");
+
+	interpolationAlpha = alpha;
+
+	// Without GPU the batches are still built, so batching is measured in headless runs
+	sprites.Begin();
+	recordingSprites = spriteBatching ? &sprites : nullptr;
+
+	CullComponents();
+
+	commands.Reset();
+	recordingCommands = &commands;
+
 	for (auto gameObject : gameObjects)
 		gameObject->Draw();
+
+	recordingCommands = nullptr;
+	recordingSprites = nullptr;
+
+	sprites.End();
+	for (const SpriteBatcher::Batch& batch : sprites.GetBatches()) {
+		DrawPacket& packet = commands.Add();
+		sprites.FillPacket(batch, packet);
+		graphics->FillSpritePacket(sprites, packet);
+		packet.layer = SPRITE_LAYER;
+	}
+
+	commands.Sort();
+}
+
+/*
+* Draw what Draw() recorded
+* Only on the thread of the immediate context: the main thread, or the render thread when pipelined
+*/
+void Game::Submit(const RenderCommandBuffer& commands) {
+	PROFILE_SCOPE("Game::Submit");
+
+	commandExecutor->Execute(commands);
 }
 
 /*
@@ -215,9 +295,9 @@ void Game::RestoreTargets() {
 * Presenting graphics
 */
 void Game::EndFrame() {
-	context->OMSetRenderTargets(0, nullptr, nullptr);
+	PROFILE_SCOPE("Game::EndFrame");
 
-	swapChain->Present(1, /*DXGI_PRESENT_DO_NOT_WAIT*/ 0); // Show what we've drawn
+	graphics->EndFrame();
 }
 
 /*
@@ -226,9 +306,37 @@ void Game::EndFrame() {
 * Call each frame
 */
 void Game::UpdateInternal() {
-	auto curTime = std::chrono::steady_clock::now();
-	deltaTime = std::chrono::duration_cast<std::chrono::microseconds>(curTime - *prevTime).count() / 1000000.0f;
-	*prevTime = curTime;
+	// Replay: frame time and input come from the log, stop at its end
+	if (inputReplayer) {
+		if (!inputReplayer->NextFrame(deltaTime, replayEvents)) {
+			window->RequestExit();
+			return;
+		}
+
+		for (const RecordedInputEvent& event : replayEvents)
+			ApplyInputEvent(event);
+	}
+
+	// Pipelined: the simulation is at most one frame ahead of the render thread
+	if (pipelined)
+		WaitForRenderThread();
+
+	long long frameStart = Profiler::Get().BeginFrame();
+	PROFILE_SCOPE("Game::UpdateInternal");
+
+	// Pipelined: frames are paced by the render thread
+	if (!inputReplayer && !pipelined)
+		framePacer->BeginFrame();
+
+	if (!inputReplayer) {
+		auto curTime = std::chrono::steady_clock::now();
+		deltaTime = std::chrono::duration_cast<std::chrono::microseconds>(curTime - *prevTime).count() / 1000000.0f;
+		*prevTime = curTime;
+	}
+
+	// Input of this frame was recorded by OnInputReceived()
+	if (inputRecorder)
+		inputRecorder->EndFrame(deltaTime);
 
 	totalTime += deltaTime;
 	frameCount++;
@@ -238,22 +346,115 @@ void Game::UpdateInternal() {
 
 		totalTime -= 1.0f;
 
-		WCHAR text[256];
-		swprintf_s(text, TEXT("FPS: %f"), fps);
-		SetWindowText(display->GetHWnd(), text);
+		wchar_t text[256];
+		if (Profiler::Get().IsEnabled()) {
+			Profiler::FrameSummary summary = Profiler::Get().GetFrameSummary();
+			std::swprintf(text, 256, L"FPS: %f, p50: %.2f ms, p95: %.2f ms, p99: %.2f ms", fps, summary.p50, summary.p95, summary.p99);
+		}
+		else
+			std::swprintf(text, 256, L"FPS: %f", fps);
+		window->SetTitle(text);
 
 		frameCount = 0;
 	}
 
-	PrepareFrame();
+	// Transient data of two frames ago is released
+	frameArena->BeginFrame();
+
+	if (!pipelined)
+		PrepareFrame();
+
+	// Input and other deferred events of this frame reach their listeners in one batch
+	eventBus->Dispatch();
+
+	fixedDeltaTime = fixedTimestep->GetFixedDeltaTime();
+	fixedTimestep->Advance(deltaTime, [this]() { FixedTick(); });
 
 	Update();
 
-	Draw();
+	// Only dirty subtrees are recomputed
+	transforms->UpdateWorldMatrices();
+
+	// Pipelined: the render thread submits this frame while the next one is simulated
+	if (pipelined)
+		PublishSnapshot(frameStart);
+	else {
+		Draw(fixedTimestep->GetAlpha(), *commandBuffer, *spriteBatcher);
+
+		Submit(*commandBuffer);
+
+		RestoreTargets();
+
+		EndFrame();
+
+		Profiler::Get().EndFrame();
+	}
+}
+
+/*
+* Backpressure of the pipeline: sleep until the render thread took the last published snapshot
+* So no snapshot is replaced unsubmitted and the simulation can't run ahead of the screen
+*/
+void Game::WaitForRenderThread() {
+	PROFILE_SCOPE("Game::WaitForRenderThread");
+
+	std::unique_lock<std::mutex> lock(renderMutex);
+	snapshotCondition.wait(lock, [this]() { return !snapshots->HasNew(); });
+}
+
+/*
+* Record the frame into the back snapshot and hand it to the render thread
+*/
+void Game::PublishSnapshot(long long frameStart) {
+	PROFILE_SCOPE("Game::PublishSnapshot");
+
+	RenderSnapshot& snapshot = snapshots->GetBack();
+	snapshot.alpha = fixedTimestep->GetAlpha();
+	snapshot.frame = ++publishedSnapshots;
+	snapshot.frameStart = frameStart;
 
-	RestoreTargets();
+	Draw(snapshot.alpha, snapshot.commands, snapshot.sprites);
 
-	EndFrame();
+	// Under the lock, so the wake-up can't be lost while the render thread is going to sleep
+	{
+		std::lock_guard<std::mutex> lock(renderMutex);
+		snapshots->Publish();
+	}
+	renderCondition.notify_one();
+}
+
+/*
+* Render thread
+* Submits every published snapshot once, in order, and never touches game objects or transforms
+* Only this thread uses the immediate context and presents while pipelined
+*/
+void Game::RenderLoop() {
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(renderMutex);
+			renderCondition.wait(lock, [this]() { return !rendering || snapshots->HasNew(); });
+
+			// The last snapshot is still submitted when rendering stops
+			if (!snapshots->Acquire())
+				break;
+		}
+		snapshotCondition.notify_one();
+
+		const RenderSnapshot& snapshot = snapshots->GetFront();
+
+		framePacer->BeginFrame();
+
+		PrepareFrame();
+
+		Submit(snapshot.commands);
+
+		RestoreTargets();
+
+		EndFrame();
+
+		// Pipelined frame time: from the start of its simulation to the present
+		Profiler::Get().EndFrame(snapshot.frameStart);
+	}
 }
 
 /*
@@ -265,19 +466,105 @@ void Game::Run() {
 
 	*startTime = std::chrono::steady_clock::now();
 	*prevTime = *startTime;
+	fixedTimestep->Reset();
+
+	graphics->SetVSync(framePacer->GetMode() == PacingMode::VSync);
+	framePacer->Reset();
+
+	// 1 ms timer resolution, so the limiter can sleep close to the frame start
+	bool precisionTimer = framePacer->GetMode() == PacingMode::TargetFps;
+	if (precisionTimer)
+		Platform::SetHighResolutionTimer(true);
 	
-	MSG msg = {};
-	while (msg.message != WM_QUIT) {
-		// Handle the windows messages.
-		if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
-			TranslateMessage(&msg);
-			DispatchMessage(&msg);
+	if (pipelined) {
+		rendering = true;
+		renderThread = std::thread(&Game::RenderLoop, this);
+	}
+
+	// Handle the windows messages, then make a frame
+	while (window->ProcessMessages())
+		UpdateInternal();
+
+	if (pipelined) {
+		{
+			std::lock_guard<std::mutex> lock(renderMutex);
+			rendering = false;
 		}
-		else
-			UpdateInternal();
+		renderCondition.notify_one();
+		renderThread.join();
 	}
+
+	if (precisionTimer)
+		Platform::SetHighResolutionTimer(false);
 	
+	auto endTime = std::chrono::steady_clock::now();
+
 	DestroyResources();
+
+	if (inputRecorder) {
+		inputRecorder->Close();
+		std::cout << "Recorded frames: " << inputRecorder->GetFrameCount() << std::endl;
+	}
+
+	if (inputRecorder || inputReplayer) {
+		std::cout << "State hash: " << std::hex << ComputeStateHash() << std::dec << std::endl;
+	}
+
+	if (inputReplayer) {
+		float seconds = std::chrono::duration<float>(endTime - *startTime).count();
+		std::cout << "Replayed frames: " << inputReplayer->GetFrameCount()
+			<< ", time: " << seconds << " s"
+			<< ", frames per second: " << (seconds > 0 ? inputReplayer->GetFrameCount() / seconds : 0) << std::endl;
+	}
+
+	if (software) {
+		const SoftwareGraphics::Totals& totals = software->GetTotals();
+		std::cout << "Software rasterizer: frames " << totals.frames
+			<< ", triangles " << totals.triangles
+			<< ", pixels " << totals.pixels
+			<< ", " << (totals.seconds > 0 ? totals.pixels / totals.seconds / 1000000.0 : 0) << " Mpixels/s"
+			<< ", " << (totals.seconds > 0 ? totals.triangles / totals.seconds : 0) << " triangles/s" << std::endl;
+	}
+
+	if (Profiler::Get().IsEnabled() && !tracePath.empty()) {
+		std::cout << "Frame arena: high-water mark " << frameArena->GetHighWaterMark() << " bytes"
+			<< " of " << frameArena->GetCapacity()
+			<< ", heap fallbacks " << frameArena->GetOverflowCount() << std::endl;
+
+		graphics->PrintStatistics(std::cout);
+
+		std::cout << "Culling (last frame): components " << drawComponents.size()
+			<< ", tested " << culler->GetCount()
+			<< ", visible " << culler->GetVisibleCount()
+			<< ", drawn " << visibleCount << std::endl;
+
+		const IRenderCommandExecutor::Statistics& commands = commandExecutor->GetStatistics();
+		std::cout << "Render commands (last frame): draws " << commands.draws
+			<< ", shader changes " << commands.shaderChanges
+			<< ", layout changes " << commands.layoutChanges
+			<< ", vertex buffer changes " << commands.vertexBufferChanges
+			<< ", constant uploads " << commands.constantUploads << std::endl;
+
+		EventBus::Statistics events = eventBus->GetStatistics();
+		std::cout << "Event bus: enqueued " << events.enqueued
+			<< ", dispatched " << events.dispatched << std::endl;
+
+		FramePacer::Statistics pacing = framePacer->GetStatistics();
+		std::cout << "Frame pacing: interval " << pacing.meanInterval << " ms"
+			<< ", jitter " << pacing.jitter << " ms"
+			<< ", lateness mean " << pacing.meanLateness << " ms"
+			<< ", p99 " << pacing.p99Lateness << " ms"
+			<< ", max " << pacing.maxLateness << " ms" << std::endl;
+
+		Profiler::FrameSummary summary = Profiler::Get().GetFrameSummary();
+		std::cout << "Frames: " << summary.frames
+			<< ", p50: " << summary.p50 << " ms"
+			<< ", p95: " << summary.p95 << " ms"
+			<< ", p99: " << summary.p99 << " ms"
+			<< ", max: " << summary.max << " ms" << std::endl;
+
+		Profiler::Get().WriteChromeTrace(tracePath);
+	}
 }
 
 /*
@@ -287,28 +574,208 @@ void Game::Exit() {
 	DestroyResources();
 }
 
+/*
+* Run fixed ticks through the scheduler without window and rendering
+* Game objects must be configured, but resources are not needed
+*/
+FixedTimestep::BenchmarkResult Game::BenchmarkFixedUpdate(unsigned int frames, float frameDeltaTime) {
+	fixedDeltaTime = fixedTimestep->GetFixedDeltaTime();
+
+	return FixedTimestep::Benchmark(
+		[this]() { FixedTick(); },
+		fixedTimestep->GetTickRate(),
+		frames,
+		frameDeltaTime,
+		fixedTimestep->GetMaxStepsPerFrame()
+	);
+}
+
+/*
+* Raw input of the window, recorded before it is applied
+*/
+void Game::OnInputReceived(const RecordedInputEvent& event) {
+	if (inputRecorder)
+		inputRecorder->Record(event);
+
+	ApplyInputEvent(event);
+}
+
+/*
+* Feed one recorded event into "inputDevice" as if it came from the window
+*/
+void Game::ApplyInputEvent(const RecordedInputEvent& event) {
+	if (event.type == RecordedInputEvent::Keyboard)
+		inputDevice->OnKeyDown({ event.makeCode, event.flags, event.vKey, event.message });
+	else
+		inputDevice->OnMouseMove({ 0, event.buttonFlags, 0, 0, event.wheelDelta, event.x, event.y });
+}
+
+/*
+* FNV-1a hash of all game object transforms
+* Equal hashes after the same replay mean bit-identical simulation state
+*/
+uint64_t Game::ComputeStateHash() {
+	uint64_t hash = Fnv1a::OFFSET;
+
+	for (auto gameObject : gameObjects) {
+		if (!transforms->IsAlive(gameObject->transform))
+			continue;
+
+		DirectX::SimpleMath::Vector3 position = transforms->GetPosition(gameObject->transform);
+		DirectX::SimpleMath::Quaternion rotation = transforms->GetRotation(gameObject->transform);
+		DirectX::SimpleMath::Vector3 scale = transforms->GetScale(gameObject->transform);
+
+		Fnv1a::Add(hash, &position, sizeof(position));
+		Fnv1a::Add(hash, &rotation, sizeof(rotation));
+		Fnv1a::Add(hash, &scale, sizeof(scale));
+	}
+
+	return hash;
+}
+
 void Game::DestroyResources() {
 	for (auto gameObject : gameObjects)
 		gameObject->DestroyResources();
+
+	if (graphics)
+		graphics->DestroyResources();
+}
+
+/*
+* Use null window and graphics backends
+* Full frame loop without window and GPU, stops after "frameLimit" frames
+* Call before Run()
+*/
+void Game::SetHeadless(unsigned int frameLimit) {
+	headless = true;
+	headlessFrameLimit = frameLimit;
 }
 
+/*
+* Enable the frame profiler
+* Chrome trace and frame time summary are written after Run()
+*/
+void Game::SetProfiling(const std::string& tracePath) {
+	this->tracePath = tracePath;
+	Profiler::Get().SetEnabled(true);
+}
+
+/*
+* Record frame times and raw input of the run into a binary log
+* Call before Run()
+*/
+void Game::SetRecording(const std::string& recordPath) {
+	inputRecorder = std::make_shared<InputRecorder>();
+	if (!inputRecorder->Open(recordPath)) {
+		std::cout << "Can't open input log for writing: " << recordPath << std::endl;
+		inputRecorder = nullptr;
+		return;
+	}
+
+	this->recordPath = recordPath;
+}
+
+/*
+* Play back a log written by SetRecording()
+* Runs headless without frame limit and as fast as possible, stops at the end of the log
+* Call before Run()
+*/
+void Game::SetReplay(const std::string& replayPath) {
+	inputReplayer = std::make_shared<InputReplayer>();
+	if (!inputReplayer->Open(replayPath)) {
+		std::cout << "Can't read input log: " << replayPath << std::endl;
+		inputReplayer = nullptr;
+		return;
+	}
+
+	this->replayPath = replayPath;
+	SetHeadless(0);
+}
+
+/*
+* Run simulation and recording on the main thread and submission on a render thread
+* Frame time becomes max(simulation, render) instead of their sum
+* Call before Run()
+*/
+void Game::SetPipelined(bool pipelined) {
+	this->pipelined = pipelined;
+}
+
+/*
+* Threads of the job system, including the main thread
+* 0 - one per hardware thread, 1 - no worker threads (everything on the main thread)
+* Call before Run()
+*/
+void Game::SetThreadCount(unsigned int threadCount) {
+	jobSystem = std::make_shared<JobSystem>(threadCount);
+}
+
+/*
+* Merge squares into one draw per render state instead of one draw per object
+* Batched squares have no mesh and are drawn after all other components, see Draw()
+* Call before Run()
+*/
+void Game::SetSpriteBatching(bool spriteBatching) {
+	this->spriteBatching = spriteBatching;
+}
+
+/*
+* Headless run with the CPU rasterizer, the last frame is written to "framePath" (PPM)
+* Runs "SOFTWARE_FRAME_LIMIT" frames unless a frame limit is set with SetHeadless() or input is replayed
+* Call before Run()
+*/
+void Game::SetSoftwareRendering(const std::string& framePath) {
+	softwareRendering = true;
+	softwareFramePath = framePath;
+	headless = true;
+}
+
+/*
+* Choose between vsync, uncapped and a frame limiter
+* Call before Run()
+*/
+void Game::SetFramePacing(PacingMode mode, float targetFps) {
+	framePacer->SetMode(mode);
+	framePacer->SetTargetFps(targetFps);
+}
+
+/*
+* Camera of all render components: culling, sort depth and the matrices in the constant buffers
+* Call before Run() or between frames
+*/
+void Game::SetViewMatrix(const DirectX::SimpleMath::Matrix& viewMatrix) {
+	this->viewMatrix = viewMatrix;
+	culler->SetViewProjection(viewMatrix);
+}
+
+const DirectX::SimpleMath::Matrix& Game::GetViewMatrix() {
+	return viewMatrix;
+}
+
+bool Game::IsSpriteBatching() {
+	return spriteBatching;
+}
+
+bool Game::IsHeadless() {
+	return headless;
+}
 
-std::shared_ptr<DisplayWin32> Game::GetDisplay() {
-	return display;
+std::shared_ptr<WindowBackend> Game::GetWindow() {
+	return window;
 }
 
-Microsoft::WRL::ComPtr<ID3D11Device> Game::GetDevice() {
-	return device;
+std::shared_ptr<GraphicsBackend> Game::GetGraphics() {
+	return graphics;
 }
 
-Microsoft::WRL::ComPtr<ID3D11RenderTargetView> Game::GetRTV() {
-	return rtv;
+std::shared_ptr<EventBus> Game::GetEventBus() {
+	return eventBus;
 }
 
-Microsoft::WRL::ComPtr <IDXGISwapChain> Game::GetSwapChain() {
-	return swapChain;
+SpriteBatcher* Game::GetSpriteBatcher() {
+	return recordingSprites;
 }
 
-Microsoft::WRL::ComPtr <ID3D11DeviceContext> Game::GetContext() {
-	return context;
+RenderCommandBuffer* Game::GetCommandBuffer() {
+	return recordingCommands;
 }
@@ -1,56 +1,105 @@
 #pragma once
-#include <windows.h>
-#include <WinUser.h>
-#include <wrl.h>
-#include <d3d.h>
-#include <d3d11.h>
-#include <d3dcompiler.h>
-#include <directxmath.h>
 #include "SimpleMath.h"
 #include "SimpleMath.inl"
 #include <iostream>
 #include <chrono>
 #include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 #include "GameObject.h"
-#include "DisplayWin32.h"
 #include "InputDevice.h"
-
-#pragma comment(lib, "d3d11.lib")
-#pragma comment(lib, "dxgi.lib")
-#pragma comment(lib, "d3dcompiler.lib")
-#pragma comment(lib, "dxguid.lib")
-
-class DisplayWin32;
+#include "FixedTimestep.h"
+#include "JobSystem.h"
+#include "EntityWorld.h"
+#include "TransformSystem.h"
+#include "InputRecording.h"
+#include "FrameArena.h"
+#include "EventBus.h"
+#include "FramePacer.h"
+#include "TripleBuffer.h"
+#include "RenderSnapshot.h"
+#include "SpriteBatcher.h"
+#include "RenderCommandBuffer.h"
+#include "FrustumCuller.h"
+#include "WindowBackend.h"
+#include "GraphicsBackend.h"
+
+class SoftwareGraphics;
 class RenderComponent;
 class InputDevice;
 
 class Game {
 protected:
-	LPCWSTR	name; // Name of the game application
+	std::wstring name; // Name of the game application
 	int clientWidth;
 	int clientHeight;
 	bool windowed;
 
-	std::shared_ptr<DisplayWin32> display; // WinApi display
-	std::shared_ptr<D3D11_VIEWPORT> viewport; // Defines the dimensions of a viewport
-	Microsoft::WRL::ComPtr<ID3D11Device> device; // The device interface represents a virtual adapter and it is used to create resources
-	Microsoft::WRL::ComPtr<ID3D11DeviceContext> context; // Interface represents a device context which generates rendering commands
-	std::shared_ptr<DXGI_SWAP_CHAIN_DESC> swapDesc; // Descriptor, that describes swap chain
-	Microsoft::WRL::ComPtr<IDXGISwapChain> swapChain; // Interface implements one or more "IDXGISurface" for storing rendered data before presenting it to an output
-	Microsoft::WRL::ComPtr<ID3D11Texture2D> backTex; // 2D texture interface manages texel data, which is structured memory
-	Microsoft::WRL::ComPtr<ID3D11RenderTargetView> rtv; // Identifies the render-target subresources that can be accessed during rendering (Back buffer?)
-
-	Game(LPCWSTR name, int clientWidth, int clientHeight, bool windowed);
+	bool headless; // Run without window and GPU
+	unsigned int headlessFrameLimit; // Number of frames for headless run (0 - until exit)
+	std::string tracePath; // Chrome trace output, written after Run() when profiling
+	std::string recordPath; // Input log written during Run()
+	std::string replayPath; // Input log played back by Run() instead of real input and time
+	std::vector<RecordedInputEvent> replayEvents; // Events of the current replayed frame
+
+	bool pipelined; // Submit recorded snapshots on the render thread while the next frame is simulated
+	std::thread renderThread;
+	std::atomic<bool> rendering; // Render thread keeps running
+	std::mutex renderMutex; // Only for sleeping of both threads, snapshots are passed lock-free
+	std::condition_variable renderCondition; // A snapshot was published or rendering stops
+	std::condition_variable snapshotCondition; // The render thread took the last published snapshot
+	std::shared_ptr<TripleBuffer<RenderSnapshot>> snapshots; // Simulation -> render thread
+	unsigned int publishedSnapshots;
+
+	std::shared_ptr<WindowBackend> window; // Window and message pump
+	std::shared_ptr<GraphicsBackend> graphics; // Device and swap chain, draws meshes and sprites
+	std::shared_ptr<SoftwareGraphics> software; // CPU rasterizer backend (nullptr if not used)
+
+	bool softwareRendering; // Headless run with the CPU rasterizer instead of the null graphics backend
+	std::string softwareFramePath; // PPM of the last software frame
+
+	bool spriteBatching; // Squares are merged into one draw per render state
+	std::shared_ptr<SpriteBatcher> spriteBatcher; // Sprites of the frame when not pipelined
+	SpriteBatcher* recordingSprites; // Inside Draw() with batching, quads go there
+
+	std::shared_ptr<RenderCommandBuffer> commandBuffer; // Draw packets of the frame when not pipelined
+	std::shared_ptr<IRenderCommandExecutor> commandExecutor; // Made by the graphics backend
+	RenderCommandBuffer* recordingCommands; // Inside Draw(), components record there
+
+	DirectX::SimpleMath::Matrix viewMatrix; // Camera, after it the view volume is [-1; 1] x [-1; 1] x [0; 1] (no projection)
+	std::shared_ptr<FrustumCuller> culler; // Bounds of render components against the view volume
+	std::vector<GameObjectComponent*> drawComponents; // All components in draw order
+	std::vector<size_t> cullIndices; // Box of every "drawComponents" item in "culler" (NO_BOUNDS - always drawn)
+	size_t visibleCount; // Components drawn by the last Draw()
+
+	// "gameObjects" split by their components, so updates walk every list once
+	std::vector<GameObject*> concurrentObjects; // Updated on the job system
+	std::vector<GameObject*> serialObjects; // Updated on the main thread
+	size_t splitObjectCount; // Size of "gameObjects" at the last split
+
+	Game(const std::wstring& name, int clientWidth, int clientHeight, bool windowed);
 
 	void UpdateInternal();
+	void OnInputReceived(const RecordedInputEvent& event);
+	void ApplyInputEvent(const RecordedInputEvent& event);
+	void WaitForRenderThread();
+	void PublishSnapshot(long long frameStart);
+	void RenderLoop();
 	void DestroyResources();
 	void PrepareResources();
 	void Initialize();
 	void PrepareFrame();
 	virtual void Update();
-	void FixedUpdate();
-	void Draw();
+	virtual void FixedUpdate();
+	void FixedTick();
+	void SplitGameObjects();
+	void CullComponents();
+	void Draw(float alpha, RenderCommandBuffer& commands, SpriteBatcher& sprites);
+	void Submit(const RenderCommandBuffer& commands);
 	void EndFrame();
 
 public:
@@ -59,29 +108,50 @@ public:
 	std::shared_ptr<InputDevice> inputDevice; // For input handling
 	std::shared_ptr<std::chrono::time_point<std::chrono::steady_clock>> startTime;
 	std::shared_ptr<std::chrono::time_point<std::chrono::steady_clock>> prevTime;
-	HRESULT res; // Used for return codes from "Direct3D 11" functions
+	std::shared_ptr<FixedTimestep> fixedTimestep; // Scheduler for FixedUpdate()
+	std::shared_ptr<JobSystem> jobSystem; // Worker threads for concurrent components
+	std::shared_ptr<EntityWorld> entities; // Data-oriented entities, run by "EntitySystemComponent"
+	std::shared_ptr<TransformSystem> transforms; // Transforms of all game objects
+	std::shared_ptr<FramePacer> framePacer; // Frame start scheduling and jitter statistics
+	std::shared_ptr<FrameArena> frameArena; // Transient allocations, valid for this and the next frame
+	std::shared_ptr<EventBus> eventBus; // Deferred events, dispatched once per frame before Update()
+	std::shared_ptr<InputRecorder> inputRecorder; // Writes input and frame times (nullptr if not recording)
+	std::shared_ptr<InputReplayer> inputReplayer; // Replaces input and frame times (nullptr if not replaying)
+	size_t jobGrainSize; // Game objects per job
 	float totalTime;
 	float deltaTime;
+	float fixedDeltaTime; // Time step of the current FixedUpdate() call
+	float interpolationAlpha; // Fraction of the fixed step between the last tick and the recorded frame
 	unsigned int frameCount;
 
-	static void CreateInstance(LPCWSTR name, int screenWidth, int screenHeight, bool windowed);
+	static void CreateInstance(const std::wstring& name, int screenWidth, int screenHeight, bool windowed);
 
 	void RestoreTargets();
 	virtual void Run();
 	void Exit();
-
-	LRESULT MessageHandler(HWND hwnd, UINT umessage, WPARAM wparam, LPARAM lparam);
-
-
-	std::shared_ptr<DisplayWin32> GetDisplay();
-
-	Microsoft::WRL::ComPtr<ID3D11Device> GetDevice();
-
-	Microsoft::WRL::ComPtr <ID3D11DeviceContext> GetContext();
-
-	Microsoft::WRL::ComPtr <IDXGISwapChain> GetSwapChain();
-
-	Microsoft::WRL::ComPtr<ID3D11RenderTargetView> GetRTV();
+	void SetHeadless(unsigned int frameLimit);
+	bool IsHeadless();
+	void SetProfiling(const std::string& tracePath);
+	void SetRecording(const std::string& recordPath);
+	void SetPipelined(bool pipelined);
+	void SetThreadCount(unsigned int threadCount);
+	void SetSpriteBatching(bool spriteBatching);
+	bool IsSpriteBatching();
+	void SetSoftwareRendering(const std::string& framePath);
+	void SetFramePacing(PacingMode mode, float targetFps = 60.0f);
+	void SetReplay(const std::string& replayPath);
+	uint64_t ComputeStateHash();
+
+	FixedTimestep::BenchmarkResult BenchmarkFixedUpdate(unsigned int frames, float frameDeltaTime);
+
+	std::shared_ptr<WindowBackend> GetWindow();
+	std::shared_ptr<GraphicsBackend> GetGraphics();
+	std::shared_ptr<EventBus> GetEventBus();
+
+	void SetViewMatrix(const DirectX::SimpleMath::Matrix& viewMatrix);
+	const DirectX::SimpleMath::Matrix& GetViewMatrix();
+
+	SpriteBatcher* GetSpriteBatcher(); // nullptr if quads must be drawn as meshes
+
+	RenderCommandBuffer* GetCommandBuffer(); // nullptr outside Draw()
 };
-
-static LRESULT CALLBACK WndProc(HWND, UINT, WPARAM, LPARAM);
@@ -1,36 +1,125 @@
 #include "GameObject.h"
+#include "Profiler.h"
+#include <typeinfo>
 
+/*
+* Game object without transform
+*/
 GameObject::GameObject() {
-	position = std::make_shared<DirectX::SimpleMath::Vector4>();
+	transforms = nullptr;
+	splitComponentCount = 0;
+}
+
+GameObject::GameObject(TransformSystem* transforms, TransformId parent) {
+	this->transforms = transforms;
+	transform = transforms->Create(parent);
+	splitComponentCount = 0;
+}
+
+GameObject::~GameObject() {
+	if (transforms)
+		transforms->Destroy(transform);
 }
 
 void GameObject::Initialize() {
 	for (auto component : components)
 		component->Initialize();
+
+	SplitComponents();
+}
+
+void GameObject::SplitComponents() {
+	if (splitComponentCount == components.size())
+		return;
+
+	concurrentComponents.clear();
+	serialComponents.clear();
+	for (auto component : components)
+		(component->IsConcurrent() ? concurrentComponents : serialComponents).push_back(component);
+
+	splitComponentCount = components.size();
 }
 
 /*
 * For logic
+* Only components that are not concurrent, on the main thread
 */
 void GameObject::Update() {
-	for (auto component : components)
+	PROFILE_SCOPE("GameObject::Update");
+
+	SplitComponents();
+	for (auto component : serialComponents) {
+		PROFILE_SCOPE(typeid(*component).name());
 		component->Update();
+	}
+}
+
+/*
+* For logic
+* Only concurrent components, may be called on a worker thread
+*/
+void GameObject::UpdateConcurrent() {
+	PROFILE_SCOPE("GameObject::UpdateConcurrent");
+
+	SplitComponents();
+	for (auto component : concurrentComponents) {
+		PROFILE_SCOPE(typeid(*component).name());
+		component->Update();
+	}
 }
 
 /*
 * For physics
+* Only components that are not concurrent, on the main thread
 */
 void GameObject::FixedUpdate() {
-	for (auto component : components)
+	PROFILE_SCOPE("GameObject::FixedUpdate");
+
+	SplitComponents();
+	for (auto component : serialComponents) {
+		PROFILE_SCOPE(typeid(*component).name());
+		component->FixedUpdate();
+	}
+}
+
+/*
+* For physics
+* Only concurrent components, may be called on a worker thread
+*/
+void GameObject::FixedUpdateConcurrent() {
+	PROFILE_SCOPE("GameObject::FixedUpdateConcurrent");
+
+	SplitComponents();
+	for (auto component : concurrentComponents) {
+		PROFILE_SCOPE(typeid(*component).name());
 		component->FixedUpdate();
+	}
 }
 
 /*
 * For rendering
+* Components culled by the game are skipped
 */
 void GameObject::Draw() {
-	for (auto component : components)
-		component->Draw();
+	PROFILE_SCOPE("GameObject::Draw");
+
+	for (size_t i = 0; i < components.size(); i++) {
+		if (i < visibleComponents.size() && !visibleComponents[i])
+			continue;
+
+		PROFILE_SCOPE(typeid(*components[i]).name());
+		components[i]->Draw();
+	}
+}
+
+bool GameObject::HasConcurrentComponents() {
+	SplitComponents();
+	return !concurrentComponents.empty();
+}
+
+bool GameObject::HasSerialComponents() {
+	SplitComponents();
+	return !serialComponents.empty();
 }
 
 void GameObject::Reload() {
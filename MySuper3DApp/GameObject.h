@@ -1,27 +1,39 @@
 #pragma once
 #include <vector>
 #include <iostream>
-#include <d3d.h>
-#include <d3d11.h>
-#include <d3dcompiler.h>
-#include <directxmath.h>
 #include "SimpleMath.h"
 #include "SimpleMath.inl"
 
 #include "GameObjectComponent.h"
+#include "TransformSystem.h"
 
 class GameObject {
+	// "components" split by IsConcurrent(), so updates don't ask every component every frame
+	std::vector<GameObjectComponent*> concurrentComponents;
+	std::vector<GameObjectComponent*> serialComponents;
+	size_t splitComponentCount; // Size of "components" at the last split
+
+	void SplitComponents(); // Again only when components were added or removed
+
 public:
-	std::shared_ptr<DirectX::SimpleMath::Vector4> position; // In the future move to Transform class
+	TransformSystem* transforms; // Owner of "transform" (may be nullptr)
+	TransformId transform; // Position, rotation, scale and parent of the object
 	std::vector<GameObjectComponent*> components;
+	std::vector<bool> visibleComponents; // Culling result of every "components" item, set by the game before Draw() (missing items are drawn)
 
 	GameObject();
-	virtual ~GameObject() = default;
+	GameObject(TransformSystem* transforms, TransformId parent = TransformId());
+	virtual ~GameObject();
 
 	virtual void Initialize();
 	virtual void Update();
+	virtual void UpdateConcurrent();
 	virtual void FixedUpdate();
+	virtual void FixedUpdateConcurrent();
 	virtual void Draw();
 	virtual void Reload();
 	virtual void DestroyResources();
+
+	bool HasConcurrentComponents(); // UpdateConcurrent() and FixedUpdateConcurrent() have work
+	bool HasSerialComponents(); // Update() and FixedUpdate() have work
 };
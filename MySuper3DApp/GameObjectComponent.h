@@ -1,4 +1,6 @@
 #pragma once
+#include "SimpleMath.h"
+#include "SimpleMath.inl"
 
 class GameObjectComponent {
 public:
@@ -10,4 +12,11 @@ public:
 	virtual void Draw() = 0;
 	virtual void Reload() = 0;
 	virtual void DestroyResources() = 0;
+
+	// Return true if Update() and FixedUpdate() touch only this component and its game object
+	// Such components are updated on worker threads
+	virtual bool IsConcurrent() { return false; }
+
+	// Local bounding box and world matrix for culling, false - no bounds, always drawn
+	virtual bool GetBounds(DirectX::BoundingBox& localBounds, DirectX::SimpleMath::Matrix& world) { return false; }
 };
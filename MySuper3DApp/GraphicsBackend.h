@@ -0,0 +1,30 @@
+#pragma once
+#include <memory>
+#include <ostream>
+#include "RenderMesh.h"
+
+class IRenderCommandExecutor;
+class SpriteBatcher;
+struct DrawPacket;
+
+/*
+* Interface of the device and swap chain part of the platform layer
+* Also creates everything that draws: meshes of render components, sprite state and the command executor
+*/
+class GraphicsBackend {
+public:
+	virtual ~GraphicsBackend() = default;
+
+	virtual void PrepareFrame() = 0; // Clear states and render targets
+	virtual void EndFrame() = 0; // Present the back buffer
+	virtual void SetVSync(bool vsync) = 0; // Wait for the vertical blank in EndFrame()
+	virtual void DestroyResources() = 0;
+
+	virtual std::shared_ptr<RenderMesh> CreateMesh(const MeshDesc& desc) = 0; // nullptr on error
+	virtual std::shared_ptr<IRenderCommandExecutor> CreateCommandExecutor() = 0; // Replays packets of meshes from CreateMesh()
+	// Shaders and states of a sprite batch packet, the geometry is filled by SpriteBatcher::FillPacket()
+	// Called while recording, backends without pipeline state objects keep the default
+	virtual void FillSpritePacket(const SpriteBatcher& batcher, DrawPacket& packet) {}
+
+	virtual void PrintStatistics(std::ostream& out) {} // Caches and counters of the backend, printed after a profiled run
+};
@@ -7,30 +7,19 @@
 using namespace DirectX::SimpleMath;
 
 
-InputDevice::InputDevice() {
+InputDevice::InputDevice()
+	: eventBus(Game::instance->GetEventBus()),
+	mouseMoveChannel(eventBus->Register<MouseMoveEventArgs>(EventPolicy::AccumulateDeltas, &InputDevice::AccumulateMouseMove)),
+	MouseMove(mouseMoveChannel->Listeners) {
 	keys = new std::unordered_set<Keys>();
 	
-	RAWINPUTDEVICE Rid[2];
-
-	Rid[0].usUsagePage = 0x01;
-	Rid[0].usUsage = 0x02;
-	Rid[0].dwFlags = 0;   // adds HID mouse and also ignores legacy mouse messages
-	Rid[0].hwndTarget = Game::instance->GetDisplay().get()->GetHWnd();
-
-	Rid[1].usUsagePage = 0x01;
-	Rid[1].usUsage = 0x06;
-	Rid[1].dwFlags = 0;   // adds HID keyboard and also ignores legacy keyboard messages
-	Rid[1].hwndTarget = Game::instance->GetDisplay().get()->GetHWnd();
-
-	if (RegisterRawInputDevices(Rid, 2, sizeof(Rid[0])) == FALSE)
-	{
-		auto errorCode = GetLastError();
-		std::cout << "ERROR: " << errorCode << std::endl;
-	}
+	// Raw input devices are registered by the window backend
 }
 
 InputDevice::~InputDevice()
 {
+	// The bus would otherwise keep dispatching to "MouseMove" of a destroyed device
+	eventBus->Unregister(mouseMoveChannel);
 	delete keys;
 }
 
@@ -65,11 +54,11 @@ void InputDevice::OnMouseMove(RawMouseEventArgs args)
 	if (args.ButtonFlags & static_cast<int>(MouseButtonFlags::MiddleButtonUp))
 		RemovePressedKey(Keys::MiddleButton);
 
-	POINT p;
-	GetCursorPos(&p);
-	ScreenToClient(Game::instance->GetDisplay().get()->GetHWnd(), &p);
-	
-	MousePosition	= Vector2(p.x, p.y);
+	// Cursor position is known only with a window (not in headless replay)
+	int x, y;
+	if (Game::instance->GetWindow()->GetCursorPosition(x, y))
+		MousePosition = Vector2(static_cast<float>(x), static_cast<float>(y));
+
 	MouseOffset		= Vector2(args.X, args.Y);
 	MouseWheelDelta = args.WheelDelta;
 
@@ -82,7 +71,15 @@ void InputDevice::OnMouseMove(RawMouseEventArgs args)
 	//	MouseOffset.y,
 	//	MouseWheelDelta);
 	
-	MouseMove.Broadcast(moveArgs);
+	// Listeners get the merged event of the frame from Game::UpdateInternal()
+	mouseMoveChannel->Enqueue(moveArgs);
+}
+
+void InputDevice::AccumulateMouseMove(MouseMoveEventArgs& accumulated, const MouseMoveEventArgs& event)
+{
+	accumulated.Position = event.Position;
+	accumulated.Offset += event.Offset;
+	accumulated.WheelDelta += event.WheelDelta;
 }
 
 void InputDevice::AddPressedKey(Keys key)
@@ -5,6 +5,8 @@
 #include "Keys.h"
 #include "SimpleMath.h"
 #include "Delegates.h"
+#include "EventBus.h"
+#include <cstdint>
 #include <unordered_set>
 
 class Game;
@@ -25,9 +27,16 @@ public:
 	DirectX::SimpleMath::Vector2 MouseOffset;
 	int MouseWheelDelta;
 
-	MulticastDelegate<const MouseMoveEventArgs&> MouseMove;
-	
+private:
+	std::shared_ptr<EventBus> eventBus; // Of the game, the channel is unregistered from it on destruction
+	// Raw mouse packets of a frame are merged: latest position, summed offset and wheel delta
+	std::shared_ptr<EventChannel<MouseMoveEventArgs>> mouseMoveChannel;
+
+	static void AccumulateMouseMove(MouseMoveEventArgs& accumulated, const MouseMoveEventArgs& event);
+
 public:
+	MulticastDelegate<const MouseMoveEventArgs&>& MouseMove; // Broadcast once per frame by Game's event bus
+
 	InputDevice();
 	~InputDevice();
 
@@ -40,16 +49,16 @@ protected:
 		/*
 		 * The "make" scan code (key depression).
 		 */
-		USHORT MakeCode;
+		uint16_t MakeCode;
 
 		/*
 		 * The flags field indicates a "break" (key release) and other
 		 * miscellaneous scan code information defined in ntddkbd.h.
 		 */
-		USHORT Flags;
+		uint16_t Flags;
 
-		USHORT VKey;
-		UINT   Message;
+		uint16_t VKey;
+		uint32_t Message;
 	};
 	
 	enum class MouseButtonFlags {
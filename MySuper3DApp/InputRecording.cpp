@@ -0,0 +1,137 @@
+#include "InputRecording.h"
+#include <cstring>
+#include <iterator>
+
+static const char RECORDING_MAGIC[4] = { 'M', 'S', 'I', 'R' };
+static const uint32_t RECORDING_VERSION = 2;
+
+template<typename T>
+static void Write(std::vector<char>& buffer, const T& value) {
+	const char* bytes = reinterpret_cast<const char*>(&value);
+	buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+InputRecorder::InputRecorder() {
+	frameCount = 0;
+}
+
+bool InputRecorder::Open(const std::string& path) {
+	file.open(path, std::ios::binary | std::ios::trunc);
+	if (!file)
+		return false;
+
+	file.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+	file.write(reinterpret_cast<const char*>(&RECORDING_VERSION), sizeof(RECORDING_VERSION));
+	frameCount = 0;
+
+	return true;
+}
+
+void InputRecorder::Record(const RecordedInputEvent& event) {
+	pendingEvents.push_back(event);
+}
+
+void InputRecorder::EndFrame(float deltaTime) {
+	if (!file)
+		return;
+
+	frameBuffer.clear();
+	Write(frameBuffer, deltaTime);
+	Write(frameBuffer, static_cast<uint32_t>(pendingEvents.size()));
+
+	for (const RecordedInputEvent& event : pendingEvents) {
+		Write(frameBuffer, event.type);
+
+		if (event.type == RecordedInputEvent::Keyboard) {
+			Write(frameBuffer, event.makeCode);
+			Write(frameBuffer, event.flags);
+			Write(frameBuffer, event.vKey);
+			Write(frameBuffer, event.message);
+		}
+		else {
+			Write(frameBuffer, event.buttonFlags);
+			Write(frameBuffer, event.wheelDelta);
+			Write(frameBuffer, event.x);
+			Write(frameBuffer, event.y);
+		}
+	}
+
+	file.write(frameBuffer.data(), frameBuffer.size());
+	pendingEvents.clear();
+	frameCount++;
+}
+
+void InputRecorder::Close() {
+	if (file.is_open())
+		file.close();
+}
+
+unsigned int InputRecorder::GetFrameCount() const {
+	return frameCount;
+}
+
+InputReplayer::InputReplayer() {
+	readOffset = 0;
+	frameCount = 0;
+}
+
+template<typename T>
+bool InputReplayer::Read(T& value) {
+	if (readOffset + sizeof(T) > data.size())
+		return false;
+
+	memcpy(&value, data.data() + readOffset, sizeof(T));
+	readOffset += sizeof(T);
+	return true;
+}
+
+/*
+* The whole log is loaded at once, so replay doesn't wait for the disk
+*/
+bool InputReplayer::Open(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+
+	data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	readOffset = 0;
+	frameCount = 0;
+
+	char magic[4];
+	uint32_t version;
+	if (!Read(magic) || memcmp(magic, RECORDING_MAGIC, sizeof(magic)) != 0)
+		return false;
+	if (!Read(version) || version != RECORDING_VERSION)
+		return false;
+
+	return true;
+}
+
+bool InputReplayer::NextFrame(float& deltaTime, std::vector<RecordedInputEvent>& events) {
+	events.clear();
+
+	uint32_t eventCount;
+	if (!Read(deltaTime) || !Read(eventCount))
+		return false;
+
+	for (uint32_t i = 0; i < eventCount; i++) {
+		RecordedInputEvent event = {};
+		if (!Read(event.type))
+			return false;
+
+		bool complete = event.type == RecordedInputEvent::Keyboard
+			? Read(event.makeCode) && Read(event.flags) && Read(event.vKey) && Read(event.message)
+			: Read(event.buttonFlags) && Read(event.wheelDelta) && Read(event.x) && Read(event.y);
+		if (!complete)
+			return false;
+
+		events.push_back(event);
+	}
+
+	frameCount++;
+	return true;
+}
+
+unsigned int InputReplayer::GetFrameCount() const {
+	return frameCount;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*
+* One raw input event in a recording
+* Only fields used by InputDevice are stored
+*/
+struct RecordedInputEvent {
+	enum Type : uint8_t {
+		Keyboard = 0,
+		Mouse = 1
+	};
+
+	uint8_t type;
+
+	// Keyboard
+	uint16_t makeCode;
+	uint16_t flags;
+	uint16_t vKey;
+	uint32_t message;
+
+	// Mouse
+	uint16_t buttonFlags;
+	int16_t wheelDelta;
+	int32_t x;
+	int32_t y;
+};
+
+/*
+* Streams per-frame "deltaTime" and input events into a binary log
+* File: "MSIR" magic, version, then frames: [float deltaTime][uint32 eventCount][events...]
+* Keyboard event takes 11 bytes, mouse event 13 bytes
+*/
+class InputRecorder {
+	std::ofstream file;
+	std::vector<RecordedInputEvent> pendingEvents; // Events of the current frame
+	std::vector<char> frameBuffer;
+	unsigned int frameCount;
+
+public:
+	InputRecorder();
+
+	bool Open(const std::string& path);
+	void Record(const RecordedInputEvent& event);
+	void EndFrame(float deltaTime); // Write the frame with all events recorded since the previous frame
+	void Close();
+
+	unsigned int GetFrameCount() const;
+};
+
+/*
+* Reads a log written by "InputRecorder" frame by frame
+*/
+class InputReplayer {
+	std::vector<char> data;
+	size_t readOffset;
+	unsigned int frameCount;
+
+	template<typename T>
+	bool Read(T& value);
+
+public:
+	InputReplayer();
+
+	bool Open(const std::string& path);
+	bool NextFrame(float& deltaTime, std::vector<RecordedInputEvent>& events); // false at the end of the log
+
+	unsigned int GetFrameCount() const;
+};
@@ -0,0 +1,149 @@
+#include "JobSystem.h"
+
+// Queue of the current thread and the pool it belongs to
+static thread_local const JobSystem* currentJobSystem = nullptr;
+static thread_local unsigned int currentQueueIndex = 0;
+
+JobSystem::JobSystem(unsigned int threadCount) {
+	if (threadCount == 0)
+		threadCount = std::thread::hardware_concurrency();
+	if (threadCount == 0)
+		threadCount = 1;
+
+	running = true;
+	pendingJobs = 0;
+
+	for (unsigned int i = 0; i < threadCount; i++)
+		queues.push_back(std::make_unique<WorkQueue>());
+
+	for (unsigned int i = 1; i < threadCount; i++)
+		workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		running = false;
+	}
+	wakeUp.notify_all();
+
+	for (auto& worker : workers)
+		worker.join();
+}
+
+/*
+* Workers use their own queue, all other threads share queue 0
+*/
+unsigned int JobSystem::GetQueueIndex() const {
+	return currentJobSystem == this ? currentQueueIndex : 0;
+}
+
+void JobSystem::Push(unsigned int queueIndex, Job&& job) {
+	{
+		std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+		queues[queueIndex]->jobs.push_back(std::move(job));
+	}
+	pendingJobs++;
+}
+
+/*
+* Take the newest job of the own queue (it is still hot in cache)
+* If it is empty, steal the oldest job of another queue
+*/
+bool JobSystem::TryRunJob(unsigned int queueIndex) {
+	Job job;
+
+	for (size_t i = 0; i < queues.size() && !job; i++) {
+		size_t index = (queueIndex + i) % queues.size();
+		WorkQueue& queue = *queues[index];
+
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.jobs.empty())
+			continue;
+
+		if (i == 0) {
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+		}
+		else {
+			job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+		}
+	}
+
+	if (!job)
+		return false;
+
+	pendingJobs--;
+	job();
+	return true;
+}
+
+void JobSystem::WorkerLoop(unsigned int queueIndex) {
+	currentJobSystem = this;
+	currentQueueIndex = queueIndex;
+
+	while (running) {
+		if (TryRunJob(queueIndex))
+			continue;
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		wakeUp.wait(lock, [this]() { return pendingJobs > 0 || !running; });
+	}
+}
+
+/*
+* Call "job" for ranges of [0; count) split by "grainSize" items on all threads
+* Returns when all ranges are done
+* The caller helps with the work, so nested calls from jobs are allowed,
+* when nothing is left to take it sleeps until the last range is finished
+*/
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const RangeJob& job) {
+	if (count == 0)
+		return;
+	if (grainSize == 0)
+		grainSize = 1;
+
+	// Not worth waking anybody up
+	if (count <= grainSize || queues.size() == 1) {
+		job(0, count);
+		return;
+	}
+
+	unsigned int queueIndex = GetQueueIndex();
+	size_t chunks = (count + grainSize - 1) / grainSize;
+	auto counter = std::make_shared<Counter>();
+	counter->remaining = chunks;
+
+	for (size_t chunk = 0; chunk < chunks; chunk++) {
+		size_t begin = chunk * grainSize;
+		size_t end = begin + grainSize < count ? begin + grainSize : count;
+
+		Push(queueIndex, [&job, counter, begin, end]() {
+			job(begin, end);
+
+			if (counter->remaining.fetch_sub(1) == 1) {
+				std::lock_guard<std::mutex> lock(counter->mutex);
+				counter->done.notify_all();
+			}
+		});
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+	wakeUp.notify_all();
+
+	while (counter->remaining > 0) {
+		if (TryRunJob(queueIndex))
+			continue;
+
+		// The rest is running on other threads
+		std::unique_lock<std::mutex> lock(counter->mutex);
+		counter->done.wait(lock, [&counter]() { return counter->remaining == 0; });
+	}
+}
+
+unsigned int JobSystem::GetThreadCount() const {
+	return static_cast<unsigned int>(queues.size());
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+* Work-stealing thread pool
+* Every thread has its own deque: the owner pushes and pops from the back,
+* idle threads steal from the front of other deques
+* The thread calling ParallelFor() works too, so "threadCount" includes it
+* With one thread there are no workers and everything runs on the caller
+*/
+class JobSystem {
+public:
+	using Job = std::function<void()>;
+	using RangeJob = std::function<void(size_t begin, size_t end)>;
+
+private:
+	struct WorkQueue {
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	// Ranges of one ParallelFor() call, shared with its jobs so it outlives the last of them
+	struct Counter {
+		std::atomic<size_t> remaining;
+		std::mutex mutex;
+		std::condition_variable done;
+	};
+
+	std::vector<std::unique_ptr<WorkQueue>> queues; // Index 0 belongs to external threads (main thread)
+	std::vector<std::thread> workers;
+	std::atomic<bool> running;
+	std::atomic<int> pendingJobs; // Jobs pushed but not yet taken
+	std::mutex sleepMutex;
+	std::condition_variable wakeUp;
+
+	unsigned int GetQueueIndex() const;
+	void Push(unsigned int queueIndex, Job&& job);
+	bool TryRunJob(unsigned int queueIndex);
+	void WorkerLoop(unsigned int queueIndex);
+
+public:
+	JobSystem(unsigned int threadCount = 0); // 0 - number of hardware threads, 1 - no worker threads
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	void ParallelFor(size_t count, size_t grainSize, const RangeJob& job);
+
+	unsigned int GetThreadCount() const;
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+struct LruCacheStatistics {
+	unsigned int hits;
+	unsigned int misses;
+	unsigned int evictions;
+};
+
+/*
+* Fixed capacity map that evicts the least recently used entry
+* Find() and Insert() make an entry the most recent one
+*/
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+	using Statistics = LruCacheStatistics;
+
+private:
+	using Entry = std::pair<Key, Value>;
+
+	std::list<Entry> entries; // Most recent first
+	std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index;
+	size_t capacity;
+	Statistics statistics;
+
+public:
+	LruCache(size_t capacity) : capacity(capacity > 0 ? capacity : 1), statistics() {}
+
+	// nullptr on a miss, the pointer is valid until the next Insert()
+	Value* Find(const Key& key) {
+		return Find(key, [](const Value&) { return true; });
+	}
+
+	// An entry for which "matches(value)" is false (a key collision) is a miss and stays where it is
+	template<typename Matches>
+	Value* Find(const Key& key, Matches matches) {
+		auto it = index.find(key);
+		if (it == index.end() || !matches(it->second->second)) {
+			statistics.misses++;
+			return nullptr;
+		}
+
+		statistics.hits++;
+		entries.splice(entries.begin(), entries, it->second);
+		return &it->second->second;
+	}
+
+	Value& Insert(const Key& key, Value value) {
+		auto it = index.find(key);
+		if (it != index.end()) {
+			it->second->second = std::move(value);
+			entries.splice(entries.begin(), entries, it->second);
+			return it->second->second;
+		}
+
+		if (entries.size() >= capacity) {
+			index.erase(entries.back().first);
+			entries.pop_back();
+			statistics.evictions++;
+		}
+
+		entries.emplace_front(key, std::move(value));
+		index[key] = entries.begin();
+		return entries.front().second;
+	}
+
+	size_t GetSize() const { return entries.size(); }
+	size_t GetCapacity() const { return capacity; }
+	const Statistics& GetStatistics() const { return statistics; }
+};
@@ -0,0 +1,107 @@
+#include "MeshRegistry.h"
+#include "Fnv1a.h"
+#include <algorithm>
+#include <cstring>
+
+static const size_t MIN_PRUNE_SIZE = 64;
+
+MeshRegistry::MeshRegistry(Microsoft::WRL::ComPtr<ID3D11Device> device) {
+	this->device = device;
+	pruneSize = MIN_PRUNE_SIZE;
+	statistics = {};
+}
+
+/*
+* Amortized: the whole map is walked only after it has doubled
+*/
+void MeshRegistry::PruneExpired() {
+	for (auto it = buffers.begin(); it != buffers.end();) {
+		if (it->second.expired())
+			it = buffers.erase(it);
+		else
+			++it;
+	}
+
+	pruneSize = std::max(MIN_PRUNE_SIZE, buffers.size() * 2);
+}
+
+/*
+* Existing buffer with the same content or a new immutable one
+*/
+std::shared_ptr<const MeshBuffer> MeshRegistry::GetBuffer(const void* data, size_t size, UINT bindFlags) {
+	statistics.requests++;
+
+	if (buffers.size() >= pruneSize)
+		PruneExpired();
+
+	Key key = { Fnv1a::Hash(data, size), size, bindFlags };
+	std::weak_ptr<const MeshBuffer>& entry = buffers[key];
+
+	std::shared_ptr<const MeshBuffer> existing = entry.lock();
+	bool collision = false;
+	if (existing) {
+		if (size == 0 || memcmp(existing->content.data(), data, size) == 0) {
+			statistics.hits++;
+			statistics.savedBytes += size;
+			return existing;
+		}
+
+		// The entry stays with its live buffer
+		statistics.collisions++;
+		collision = true;
+	}
+
+	D3D11_BUFFER_DESC bufferDesc = {};
+	bufferDesc.ByteWidth = static_cast<UINT>(size);
+	bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+	bufferDesc.BindFlags = bindFlags;
+	bufferDesc.CPUAccessFlags = 0;
+	bufferDesc.MiscFlags = 0;
+	bufferDesc.StructureByteStride = 0;
+
+	D3D11_SUBRESOURCE_DATA bufferData = {};
+	bufferData.pSysMem = data;
+	bufferData.SysMemPitch = 0;
+	bufferData.SysMemSlicePitch = 0;
+
+	auto meshBuffer = std::make_shared<MeshBuffer>();
+	meshBuffer->size = size;
+	meshBuffer->hash = key.hash;
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	meshBuffer->content.assign(bytes, bytes + size);
+
+	HRESULT res = device->CreateBuffer(&bufferDesc, &bufferData, meshBuffer->buffer.GetAddressOf());
+	if (FAILED(res)) {
+		if (!collision)
+			buffers.erase(key);
+		return nullptr;
+	}
+
+	statistics.creations++;
+	statistics.createdBytes += size;
+
+	if (!collision)
+		entry = meshBuffer;
+	return meshBuffer;
+}
+
+std::shared_ptr<const MeshBuffer> MeshRegistry::GetVertexBuffer(const void* data, size_t size) {
+	return GetBuffer(data, size, D3D11_BIND_VERTEX_BUFFER);
+}
+
+std::shared_ptr<const MeshBuffer> MeshRegistry::GetIndexBuffer(const void* data, size_t size) {
+	return GetBuffer(data, size, D3D11_BIND_INDEX_BUFFER);
+}
+
+size_t MeshRegistry::GetLiveCount() const {
+	size_t count = 0;
+	for (const auto& entry : buffers)
+		if (!entry.second.expired())
+			count++;
+
+	return count;
+}
+
+const MeshRegistry::Statistics& MeshRegistry::GetStatistics() const {
+	return statistics;
+}
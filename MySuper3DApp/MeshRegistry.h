@@ -0,0 +1,68 @@
+#pragma once
+#include <wrl.h>
+#include <d3d11.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/*
+* GPU buffer shared by all meshes with the same content
+*/
+struct MeshBuffer {
+	Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+	size_t size; // Bytes
+	uint64_t hash; // Of the content
+	std::vector<unsigned char> content; // Copy of the bytes, compared on a hash hit
+};
+
+/*
+* Deduplicates immutable vertex and index buffers by content
+* Buffers are found by a 64-bit FNV-1a hash of the bytes, the size and the bind flags,
+* equal geometry of many objects (the quad index pattern, identical meshes) is created once
+* A hit is confirmed by comparing the bytes, a colliding content gets its own unshared buffer
+* The registry keeps weak references: a buffer is released with its last user,
+* expired entries are pruned when the map has doubled since the last pruning
+*/
+class MeshRegistry {
+public:
+	struct Statistics {
+		unsigned int requests;
+		unsigned int hits;
+		unsigned int creations; // Buffers created on the device
+		size_t createdBytes;
+		size_t savedBytes; // Bytes not created thanks to hits
+		unsigned int collisions; // Equal keys with different content
+	};
+
+private:
+	struct Key {
+		uint64_t hash;
+		size_t size;
+		UINT bindFlags;
+
+		bool operator==(const Key& other) const { return hash == other.hash && size == other.size && bindFlags == other.bindFlags; }
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& key) const { return static_cast<size_t>(key.hash ^ (key.size * 31 + key.bindFlags)); }
+	};
+
+	Microsoft::WRL::ComPtr<ID3D11Device> device;
+	std::unordered_map<Key, std::weak_ptr<const MeshBuffer>, KeyHash> buffers;
+	size_t pruneSize; // Map size that triggers the next pruning
+	Statistics statistics;
+
+	void PruneExpired();
+	std::shared_ptr<const MeshBuffer> GetBuffer(const void* data, size_t size, UINT bindFlags);
+
+public:
+	MeshRegistry(Microsoft::WRL::ComPtr<ID3D11Device> device);
+
+	// nullptr if the buffer can't be created
+	std::shared_ptr<const MeshBuffer> GetVertexBuffer(const void* data, size_t size);
+	std::shared_ptr<const MeshBuffer> GetIndexBuffer(const void* data, size_t size);
+
+	size_t GetLiveCount() const; // Buffers with users
+	const Statistics& GetStatistics() const;
+};
@@ -1,9 +1,73 @@
 #include "Game.h"
 #include "PingPongGame.h"
 #include "SquareRenderComponent.h"
+#include "Benchmarks.h"
+#include <cctype>
+#include <cstdlib>
+
+int main(int argc, char* argv[]) {
+	// Headless benchmarks: MySuper3DApp.exe --benchmark <name>
+	if (argc > 2 && std::string(argv[1]) == "--benchmark")
+		return Benchmarks::Run(argv[2]) ? 0 : 1;
 
-int main() {
 	//PingPongGame::CreateInstance(L"Ping Pong", 1920, 1080, false);
 	PingPongGame::CreateInstance(L"Ping Pong", 1280, 720, true);
+
+	// Options, any combination:
+	// Frame profiler: --profile trace.json
+	// Input recording: --record input.bin
+	// Headless max-speed replay: --replay input.bin
+	// Simulation and render threads: --pipelined
+	// Draw every square separately: --no-batching
+	// Frame pacing: --pacing vsync | uncapped | <target fps>
+	// Job system threads including the main one: --threads <count> (0 - hardware threads, 1 - no workers)
+	// CPU rendering without GPU, last frame saved as PPM: --software frame.ppm
+	for (int i = 1; i < argc; i++) {
+		std::string option = argv[i];
+
+		if (option == "--pipelined")
+			PingPongGame::instance->SetPipelined(true);
+		else if (option == "--no-batching")
+			PingPongGame::instance->SetSpriteBatching(false);
+		else if (i + 1 < argc) {
+			std::string value = argv[++i];
+
+			if (option == "--profile")
+				PingPongGame::instance->SetProfiling(value);
+			else if (option == "--record")
+				PingPongGame::instance->SetRecording(value);
+			else if (option == "--replay")
+				PingPongGame::instance->SetReplay(value);
+			else if (option == "--software")
+				PingPongGame::instance->SetSoftwareRendering(value);
+			else if (option == "--threads") {
+				char* end = nullptr;
+				unsigned long threads = std::strtoul(value.c_str(), &end, 10);
+				if (!std::isdigit(static_cast<unsigned char>(value[0])) || *end != '\0') {
+					std::cout << "Usage: --threads <count>, 0 - hardware threads, 1 - main thread only" << std::endl;
+					return 1;
+				}
+
+				PingPongGame::instance->SetThreadCount(static_cast<unsigned int>(threads));
+			}
+			else if (option == "--pacing") {
+				if (value == "vsync")
+					PingPongGame::instance->SetFramePacing(PacingMode::VSync);
+				else if (value == "uncapped")
+					PingPongGame::instance->SetFramePacing(PacingMode::Uncapped);
+				else {
+					char* end = nullptr;
+					float fps = std::strtof(value.c_str(), &end);
+					if (end == value.c_str() || *end != '\0' || !(fps > 0)) {
+						std::cout << "Usage: --pacing vsync | uncapped | <target fps above 0>" << std::endl;
+						return 1;
+					}
+
+					PingPongGame::instance->SetFramePacing(PacingMode::TargetFps, fps);
+				}
+			}
+		}
+	}
+
 	PingPongGame::instance->Run();
 }
@@ -0,0 +1,76 @@
+#include "NullBackend.h"
+#include "RenderCommandBuffer.h"
+
+NullWindow::NullWindow(int clientWidth, int clientHeight, unsigned int frameLimit) {
+	this->clientWidth = clientWidth;
+	this->clientHeight = clientHeight;
+	this->frameLimit = frameLimit;
+
+	frameCount = 0;
+	exitRequested = false;
+}
+
+/*
+* There are no messages, only the frame limit
+*/
+bool NullWindow::ProcessMessages() {
+	if (exitRequested || (frameLimit > 0 && frameCount >= frameLimit))
+		return false;
+
+	frameCount++;
+	return true;
+}
+
+void NullWindow::RequestExit() {
+	exitRequested = true;
+}
+
+/*
+* Nobody can see the title
+*/
+void NullWindow::SetTitle(const std::wstring& title) {
+
+}
+
+int NullWindow::GetClientWidth() {
+	return clientWidth;
+}
+
+int NullWindow::GetClientHeight() {
+	return clientHeight;
+}
+
+/*
+* Replayed input has offsets only
+*/
+bool NullWindow::GetCursorPosition(int& x, int& y) {
+	return false;
+}
+
+unsigned int NullWindow::GetFrameCount() const {
+	return frameCount;
+}
+
+void NullGraphics::PrepareFrame() {
+
+}
+
+void NullGraphics::EndFrame() {
+
+}
+
+void NullGraphics::SetVSync(bool vsync) {
+
+}
+
+void NullGraphics::DestroyResources() {
+
+}
+
+std::shared_ptr<RenderMesh> NullGraphics::CreateMesh(const MeshDesc& desc) {
+	return std::make_shared<CpuRenderMesh>(desc);
+}
+
+std::shared_ptr<IRenderCommandExecutor> NullGraphics::CreateCommandExecutor() {
+	return std::make_shared<CountingCommandExecutor>();
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "WindowBackend.h"
+#include "GraphicsBackend.h"
+
+/*
+* Window without a window
+* Runs a given number of frames and then asks the application to quit
+*/
+class NullWindow : public WindowBackend {
+protected:
+	int clientWidth;
+	int clientHeight;
+	unsigned int frameLimit; // 0 - run until RequestExit()
+	unsigned int frameCount;
+	bool exitRequested;
+
+public:
+	NullWindow(int clientWidth, int clientHeight, unsigned int frameLimit);
+
+	bool ProcessMessages() override;
+	void RequestExit() override;
+	void SetTitle(const std::wstring& title) override;
+
+	int GetClientWidth() override;
+	int GetClientHeight() override;
+	bool GetCursorPosition(int& x, int& y) override;
+
+	unsigned int GetFrameCount() const;
+};
+
+/*
+* Graphics backend without a GPU
+* Every call is a no-op, so only the CPU side of a frame is measured
+* Draw packets are counted instead of executed
+*/
+class NullGraphics : public GraphicsBackend {
+public:
+	void PrepareFrame() override;
+	void EndFrame() override;
+	void SetVSync(bool vsync) override;
+	void DestroyResources() override;
+
+	std::shared_ptr<RenderMesh> CreateMesh(const MeshDesc& desc) override;
+	std::shared_ptr<IRenderCommandExecutor> CreateCommandExecutor() override;
+};
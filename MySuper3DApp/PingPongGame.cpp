@@ -1,47 +1,66 @@
 #include "PingPongGame.h"
+#include "BallComponent.h"
+#include <cmath>
 
-PingPongGame::PingPongGame(LPCWSTR name, int screenWidth, int screenHeight, bool windowed) :
+// Local rectangles of the meshes below
+static const DirectX::BoundingBox LEFT_RACKET_BOUNDS(DirectX::XMFLOAT3(-0.9f, 0.0f, 0.5f), DirectX::XMFLOAT3(0.1f, 0.5f, 0.0f));
+static const DirectX::BoundingBox RIGHT_RACKET_BOUNDS(DirectX::XMFLOAT3(0.9f, 0.0f, 0.5f), DirectX::XMFLOAT3(0.1f, 0.5f, 0.0f));
+static const DirectX::BoundingBox BALL_BOUNDS(DirectX::XMFLOAT3(-0.03f, -0.05f, 0.5f), DirectX::XMFLOAT3(0.03f, 0.05f, 0.0f));
+
+PingPongGame::PingPongGame(const std::wstring& name, int screenWidth, int screenHeight, bool windowed) :
 	Game(name, screenWidth, screenHeight, windowed) {
-	leftPlayer = std::make_shared<GameObject>();
-	rightPlayer = std::make_shared<GameObject>();
-	ball = std::make_shared<GameObject>();
+	leftPlayer = std::make_shared<GameObject>(transforms.get());
+	rightPlayer = std::make_shared<GameObject>(transforms.get());
+	ball = std::make_shared<GameObject>(transforms.get());
 }
 
 /*
 * Call Game::Update() for base logic
-* Handle input player here because of better time control
 */
 void PingPongGame::Update() {
 	Game::Update();
+}
+
+/*
+* Call Game::FixedUpdate() for base physics
+* Handle input player here because of better time control
+* Movement uses "fixedDeltaTime", so the speed doesn't depend on the frame rate
+*/
+void PingPongGame::FixedUpdate() {
+	Game::FixedUpdate();
+
+	// There is no input device in headless runs (benchmarks)
+	if (!inputDevice)
+		return;
 
 	// Input of left player
 	// Change on internal logic in future
 	if (inputDevice->IsKeyDown(Keys::A))
-		*leftPlayer->position -= {0.25f * deltaTime, 0.0f, 0.0f, 0.0f};
+		transforms->Translate(leftPlayer->transform, { -0.25f * fixedDeltaTime, 0.0f, 0.0f });
 	if (inputDevice->IsKeyDown(Keys::D))
-		*leftPlayer->position += {0.25f * deltaTime, 0.0f, 0.0f, 0.0f};
+		transforms->Translate(leftPlayer->transform, { 0.25f * fixedDeltaTime, 0.0f, 0.0f });
 	if (inputDevice->IsKeyDown(Keys::W))
-		*leftPlayer->position += {0.0f, 0.5f * deltaTime, 0.0f, 0.0f};
+		transforms->Translate(leftPlayer->transform, { 0.0f, 0.5f * fixedDeltaTime, 0.0f });
 	if (inputDevice->IsKeyDown(Keys::S))
-		*leftPlayer->position -= {0.0f, 0.5f * deltaTime, 0.0f, 0.0f};
+		transforms->Translate(leftPlayer->transform, { 0.0f, -0.5f * fixedDeltaTime, 0.0f });
 
 	// Input of right player
 	// Change on internal logic in future
 	if (inputDevice->IsKeyDown(Keys::Left))
-		*rightPlayer->position -= {0.25f * deltaTime, 0.0f, 0.0f, 0.0f};
+		transforms->Translate(rightPlayer->transform, { -0.25f * fixedDeltaTime, 0.0f, 0.0f });
 	if (inputDevice->IsKeyDown(Keys::Right))
-		*rightPlayer->position += {0.25f * deltaTime, 0.0f, 0.0f, 0.0f};
+		transforms->Translate(rightPlayer->transform, { 0.25f * fixedDeltaTime, 0.0f, 0.0f });
 	if (inputDevice->IsKeyDown(Keys::Up))
-		*rightPlayer->position += {0.0f, 0.5f * deltaTime, 0.0f, 0.0f};
+		transforms->Translate(rightPlayer->transform, { 0.0f, 0.5f * fixedDeltaTime, 0.0f });
 	if (inputDevice->IsKeyDown(Keys::Down))
-		*rightPlayer->position -= {0.0f, 0.5f * deltaTime, 0.0f, 0.0f};
+		transforms->Translate(rightPlayer->transform, { 0.0f, -0.5f * fixedDeltaTime, 0.0f });
 }
 
 /*
 * There is no public access to constructor because of "Singleton" pattern
 * Need to use this method to create Game::instance (PingPongGame)
 */
-void PingPongGame::CreateInstance(LPCWSTR name, int screenWidth, int screenHeight, bool windowed) {
+void PingPongGame::CreateInstance(const std::wstring& name, int screenWidth, int screenHeight, bool windowed) {
 	if (!instance)
 		instance = new PingPongGame(name, screenWidth, screenHeight, windowed);
 }
@@ -61,9 +80,9 @@ void PingPongGame::Run() {
 * Configure score game objects
 */
 void PingPongGame::ConfigureGameObjects() {
-	SquareRenderComponent* leftPlayerRacket = new SquareRenderComponent(leftPlayer->position);
-	SquareRenderComponent* rightPlayerRacket = new SquareRenderComponent(rightPlayer->position);
-	SquareRenderComponent* ballMesh = new SquareRenderComponent();
+	SquareRenderComponent* leftPlayerRacket = new SquareRenderComponent(transforms.get(), leftPlayer->transform);
+	SquareRenderComponent* rightPlayerRacket = new SquareRenderComponent(transforms.get(), rightPlayer->transform);
+	SquareRenderComponent* ballMesh = new SquareRenderComponent(transforms.get(), ball->transform);
 
 	leftPlayerRacket->points.insert(leftPlayerRacket->points.end(),
 		{
@@ -95,12 +114,42 @@ void PingPongGame::ConfigureGameObjects() {
 		}
 	);
 
+	BallComponent* ballPhysics = new BallComponent(transforms.get(), ball->transform, BALL_BOUNDS,
+		leftPlayer->transform, LEFT_RACKET_BOUNDS, rightPlayer->transform, RIGHT_RACKET_BOUNDS, { 0.6f, 0.4f });
+
 	leftPlayer->components.push_back(leftPlayerRacket);
 	rightPlayer->components.push_back(rightPlayerRacket);
 	ball->components.push_back(ballMesh);
+	ball->components.push_back(ballPhysics);
 
 	// Adding all game objects to Game::gameObjects for their initialization
 	PingPongGame::instance->gameObjects.push_back(leftPlayer.get());
 	PingPongGame::instance->gameObjects.push_back(rightPlayer.get());
 	PingPongGame::instance->gameObjects.push_back(ball.get());
 }
+
+/*
+* More balls with the same mesh in different directions
+* For stress runs and the fixed tick benchmark
+*/
+void PingPongGame::SpawnBalls(size_t count) {
+	SquareRenderComponent* ballMesh = static_cast<SquareRenderComponent*>(ball->components[0]);
+
+	for (size_t i = 0; i < count; i++) {
+		auto extraBall = std::make_shared<GameObject>(transforms.get());
+
+		SquareRenderComponent* mesh = new SquareRenderComponent(transforms.get(), extraBall->transform);
+		mesh->points = ballMesh->points;
+
+		float angle = 0.3f + 6.2831853f * i / count;
+		DirectX::SimpleMath::Vector2 velocity(0.7f * cosf(angle), 0.5f * sinf(angle));
+		BallComponent* physics = new BallComponent(transforms.get(), extraBall->transform, BALL_BOUNDS,
+			leftPlayer->transform, LEFT_RACKET_BOUNDS, rightPlayer->transform, RIGHT_RACKET_BOUNDS, velocity);
+
+		extraBall->components.push_back(mesh);
+		extraBall->components.push_back(physics);
+
+		extraBalls.push_back(extraBall);
+		gameObjects.push_back(extraBall.get());
+	}
+}
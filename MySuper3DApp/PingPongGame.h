@@ -5,17 +5,20 @@
 
 class PingPongGame : public Game {
 private:
-	PingPongGame(LPCWSTR name, int screenWidth, int screenHeight, bool windowed);
+	PingPongGame(const std::wstring& name, int screenWidth, int screenHeight, bool windowed);
 
 	void Update() override;
+	void FixedUpdate() override;
 
 public:
 	std::shared_ptr<GameObject> leftPlayer;
 	std::shared_ptr<GameObject> rightPlayer;
 	std::shared_ptr<GameObject> ball;
+	std::vector<std::shared_ptr<GameObject>> extraBalls; // Made by SpawnBalls()
 
-	static void CreateInstance(LPCWSTR name, int screenWidth, int screenHeight, bool windowed);
+	static void CreateInstance(const std::wstring& name, int screenWidth, int screenHeight, bool windowed);
 
 	void Run() override;
 	void ConfigureGameObjects();
+	void SpawnBalls(size_t count); // Call after ConfigureGameObjects()
 };
@@ -0,0 +1,47 @@
+#include "Platform.h"
+#ifdef _WIN32
+#include "DisplayWin32.h"
+#include "D3D11GraphicsBackend.h"
+#include "D3DShaderCompiler.h"
+#include <timeapi.h>
+
+#pragma comment(lib, "winmm.lib")
+#else
+#include "StubShaderCompiler.h"
+#endif
+
+std::shared_ptr<WindowBackend> Platform::CreateWindowBackend(const std::wstring& name, int clientWidth, int clientHeight, std::shared_ptr<FrameArena> frameArena) {
+#ifdef _WIN32
+	return std::make_shared<DisplayWin32>(name, clientWidth, clientHeight, frameArena);
+#else
+	return nullptr;
+#endif
+}
+
+std::shared_ptr<GraphicsBackend> Platform::CreateGraphicsBackend(std::shared_ptr<WindowBackend> window, bool windowed) {
+#ifdef _WIN32
+	return std::make_shared<D3D11GraphicsBackend>(std::static_pointer_cast<DisplayWin32>(window), windowed);
+#else
+	return nullptr;
+#endif
+}
+
+std::shared_ptr<IShaderCompiler> Platform::CreateShaderCompiler() {
+#ifdef _WIN32
+	return std::make_shared<D3DShaderCompiler>();
+#else
+	return std::make_shared<StubShaderCompiler>();
+#endif
+}
+
+/*
+* Default Windows timer resolution is 15.6 ms, other platforms already sleep precisely
+*/
+void Platform::SetHighResolutionTimer(bool enabled) {
+#ifdef _WIN32
+	if (enabled)
+		timeBeginPeriod(1);
+	else
+		timeEndPeriod(1);
+#endif
+}
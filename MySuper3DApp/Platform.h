@@ -0,0 +1,27 @@
+#pragma once
+#include <memory>
+#include <string>
+
+class WindowBackend;
+class GraphicsBackend;
+class FrameArena;
+class IShaderCompiler;
+
+/*
+* Services of the operating system the engine core uses
+* Only Platform.cpp knows the native window and GPU APIs,
+* platforms without them return nullptr and the game runs with the null backends
+*/
+class Platform {
+public:
+	// Native window with raw input (nullptr if there is none on this platform)
+	static std::shared_ptr<WindowBackend> CreateWindowBackend(const std::wstring& name, int clientWidth, int clientHeight, std::shared_ptr<FrameArena> frameArena);
+	// GPU device and swap chain for a window of CreateWindowBackend()
+	static std::shared_ptr<GraphicsBackend> CreateGraphicsBackend(std::shared_ptr<WindowBackend> window, bool windowed);
+
+	// HLSL compiler, a stub that only checks the entry point where there is none
+	static std::shared_ptr<IShaderCompiler> CreateShaderCompiler();
+
+	// 1 ms sleep granularity while enabled, so frame limiters can wake up on time
+	static void SetHighResolutionTimer(bool enabled);
+};
@@ -0,0 +1,186 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+Profiler::Profiler() {
+	enabled = false;
+	startTime = std::chrono::steady_clock::now();
+	eventsPerThread = 1 << 16;
+
+	frameTimes.resize(4096);
+	frameIndex = 0;
+	frameStart = 0;
+}
+
+Profiler& Profiler::Get() {
+	static Profiler profiler;
+	return profiler;
+}
+
+void Profiler::SetEnabled(bool enabled) {
+	this->enabled = enabled;
+}
+
+bool Profiler::IsEnabled() const {
+	return enabled.load(std::memory_order_relaxed);
+}
+
+long long Profiler::Now() const {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+/*
+* Buffer of the current thread, registered on the first use
+*/
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer() {
+	static thread_local ThreadBuffer* threadBuffer = nullptr;
+
+	if (!threadBuffer) {
+		auto buffer = std::make_shared<ThreadBuffer>();
+		buffer->events.resize(eventsPerThread);
+		buffer->writeIndex = 0;
+		buffer->depth = 0;
+
+		std::lock_guard<std::mutex> lock(buffersMutex);
+		buffer->threadId = static_cast<unsigned int>(buffers.size());
+		buffers.push_back(buffer);
+		threadBuffer = buffer.get();
+	}
+
+	return *threadBuffer;
+}
+
+/*
+* Frame time is measured on the main thread between BeginFrame() and EndFrame()
+* A pipelined frame ends on the render thread with the start passed along with the frame
+*/
+long long Profiler::BeginFrame() {
+	frameStart = Now();
+	return frameStart;
+}
+
+void Profiler::EndFrame() {
+	EndFrame(frameStart);
+}
+
+void Profiler::EndFrame(long long frameStart) {
+	long long end = Now();
+
+	std::lock_guard<std::mutex> lock(framesMutex);
+	frameTimes[frameIndex % frameTimes.size()] = (end - frameStart) / 1000000000.0f;
+	frameIndex++;
+}
+
+/*
+* Percentiles of the last recorded frames
+*/
+Profiler::FrameSummary Profiler::GetFrameSummary() {
+	FrameSummary summary = {};
+	std::vector<float> sorted;
+
+	{
+		std::lock_guard<std::mutex> lock(framesMutex);
+		size_t count = std::min(frameIndex, frameTimes.size());
+		sorted.assign(frameTimes.begin(), frameTimes.begin() + count);
+	}
+
+	if (sorted.empty())
+		return summary;
+
+	std::sort(sorted.begin(), sorted.end());
+
+	auto percentile = [&sorted](float p) {
+		size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5f);
+		return sorted[index] * 1000.0f;
+	};
+
+	summary.frames = static_cast<unsigned int>(sorted.size());
+	summary.p50 = percentile(0.50f);
+	summary.p95 = percentile(0.95f);
+	summary.p99 = percentile(0.99f);
+	summary.max = sorted.back() * 1000.0f;
+
+	return summary;
+}
+
+static void WriteJsonString(std::ofstream& out, const char* text) {
+	out << '"';
+	for (const char* c = text; *c; c++) {
+		if (*c == '"' || *c == '\\')
+			out << '\\';
+		out << *c;
+	}
+	out << '"';
+}
+
+/*
+* Dump all buffers to Chrome "trace_event" JSON
+* Call when the profiled threads are idle, otherwise the oldest events may be half overwritten
+*/
+bool Profiler::WriteChromeTrace(const std::string& path) {
+	std::ofstream out(path);
+	if (!out)
+		return false;
+
+	out << std::fixed << std::setprecision(3);
+	out << "{\"traceEvents\":[\n";
+	bool first = true;
+
+	std::lock_guard<std::mutex> lock(buffersMutex);
+	for (auto& buffer : buffers) {
+		unsigned long long written = buffer->writeIndex.load(std::memory_order_acquire);
+		unsigned long long count = std::min<unsigned long long>(written, buffer->events.size());
+
+		for (unsigned long long i = written - count; i < written; i++) {
+			const Event& event = buffer->events[i % buffer->events.size()];
+
+			if (!first)
+				out << ",\n";
+			first = false;
+
+			out << "{\"name\":";
+			WriteJsonString(out, event.name);
+			out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->threadId
+				<< ",\"ts\":" << event.start / 1000.0
+				<< ",\"dur\":" << (event.end - event.start) / 1000.0
+				<< ",\"args\":{\"depth\":" << event.depth << "}}";
+		}
+	}
+
+	out << "\n]}\n";
+	return true;
+}
+
+ProfileScope::ProfileScope(const char* name) {
+	this->name = name;
+	buffer = nullptr;
+	start = 0;
+
+	Profiler& profiler = Profiler::Get();
+	if (!profiler.IsEnabled())
+		return;
+
+	buffer = &profiler.GetThreadBuffer();
+	buffer->depth++;
+	start = profiler.Now();
+}
+
+/*
+* Only the owner thread writes, so a release store of the index is enough
+*/
+ProfileScope::~ProfileScope() {
+	if (!buffer)
+		return;
+
+	buffer->depth--;
+
+	unsigned long long index = buffer->writeIndex.load(std::memory_order_relaxed);
+	Profiler::Event& event = buffer->events[index % buffer->events.size()];
+	event.name = name;
+	event.start = start;
+	event.end = Profiler::Get().Now();
+	event.depth = buffer->depth;
+
+	buffer->writeIndex.store(index + 1, std::memory_order_release);
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+* Hierarchical CPU frame profiler
+* Scoped timers write into a per-thread ring buffer without locks,
+* the buffers can be dumped to Chrome "trace_event" JSON (chrome://tracing, Perfetto)
+*/
+class Profiler {
+public:
+	struct Event {
+		const char* name; // Must be a string literal or live until the dump
+		long long start; // Nanoseconds since profiler start
+		long long end;
+		unsigned int depth; // Nesting level on the thread
+	};
+
+	struct FrameSummary {
+		unsigned int frames;
+		float p50; // Frame time percentiles (in milliseconds)
+		float p95;
+		float p99;
+		float max;
+	};
+
+	// Single writer (owner thread) ring buffer
+	struct ThreadBuffer {
+		std::vector<Event> events;
+		std::atomic<unsigned long long> writeIndex;
+		unsigned int threadId;
+		unsigned int depth;
+	};
+
+private:
+	std::atomic<bool> enabled;
+	std::chrono::steady_clock::time_point startTime;
+	std::mutex buffersMutex; // Only for registration of a new thread and dump
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+	size_t eventsPerThread;
+
+	std::mutex framesMutex; // Frames may end on another thread than the one reading the summary
+	std::vector<float> frameTimes; // Ring of the last frame times (in seconds)
+	size_t frameIndex;
+	long long frameStart;
+
+	Profiler();
+
+public:
+	static Profiler& Get();
+
+	void SetEnabled(bool enabled);
+	bool IsEnabled() const;
+
+	long long Now() const;
+	ThreadBuffer& GetThreadBuffer();
+
+	long long BeginFrame(); // Returns the frame start
+	void EndFrame();
+	void EndFrame(long long frameStart); // Frame started by BeginFrame() on another thread
+	FrameSummary GetFrameSummary();
+
+	bool WriteChromeTrace(const std::string& path);
+};
+
+/*
+* Measures time from construction to destruction
+*/
+class ProfileScope {
+	const char* name;
+	long long start;
+	Profiler::ThreadBuffer* buffer;
+
+public:
+	ProfileScope(const char* name);
+	~ProfileScope();
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define PROFILE_CONCAT_INTERNAL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INTERNAL(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
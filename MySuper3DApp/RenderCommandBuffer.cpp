@@ -0,0 +1,140 @@
+#include "RenderCommandBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+uint64_t RenderCommandBuffer::MakeKey(uint32_t layer, uint32_t pass, uint32_t shader, uint32_t layout, uint32_t buffer, float depth) {
+	// Depth [0; 1] front to back
+	depth = std::min(std::max(depth, 0.0f), 1.0f);
+	uint64_t depthBits = static_cast<uint64_t>(depth * 65535.0f);
+
+	return (static_cast<uint64_t>(layer & 0xF) << 60)
+		| (static_cast<uint64_t>(pass & 0xF) << 56)
+		| (static_cast<uint64_t>(shader & 0xFFFF) << 40)
+		| (static_cast<uint64_t>(layout & 0xFF) << 32)
+		| (static_cast<uint64_t>(buffer & 0xFFFF) << 16)
+		| depthBits;
+}
+
+void RenderCommandBuffer::Reset() {
+	packets.clear();
+	order.clear();
+}
+
+DrawPacket& RenderCommandBuffer::Add() {
+	packets.emplace_back();
+	DrawPacket& packet = packets.back();
+	memset(&packet, 0, sizeof(packet));
+	return packet;
+}
+
+void RenderCommandBuffer::Append(const RenderCommandBuffer& other) {
+	packets.insert(packets.end(), other.packets.begin(), other.packets.end());
+}
+
+uint32_t RenderCommandBuffer::GetResourceId(const void* resource) {
+	if (!resource)
+		return 0;
+
+	auto found = resourceIds.find(resource);
+	if (found != resourceIds.end())
+		return found->second;
+
+	uint32_t id = static_cast<uint32_t>(resourceIds.size() + 1);
+	resourceIds[resource] = id;
+	return id;
+}
+
+/*
+* Keys are made here, not while recording: resource ids then come from one table of this frame,
+* so merged buffers agree on them and resources of destroyed meshes don't stay in the table
+* LSD radix sort of packet indices by key, 8 bits per pass
+* Histograms of all 8 digits are made in one pass over the keys,
+* a digit equal for all packets (common for high bits) is skipped
+* Stable, so packets with equal keys stay in recording order
+*/
+void RenderCommandBuffer::Sort() {
+	resourceIds.clear();
+	for (DrawPacket& packet : packets)
+		packet.key = MakeKey(packet.layer, packet.pass, GetResourceId(packet.vertexShader), GetResourceId(packet.inputLayout), GetResourceId(packet.vertexBuffer), packet.depth);
+
+	size_t count = packets.size();
+	order.resize(count);
+	tempOrder.resize(count);
+
+	for (size_t i = 0; i < count; i++)
+		order[i] = static_cast<uint32_t>(i);
+
+	if (count < 2)
+		return;
+
+	uint32_t histograms[8][256] = {};
+	for (const DrawPacket& packet : packets)
+		for (int digit = 0; digit < 8; digit++)
+			histograms[digit][(packet.key >> (digit * 8)) & 0xFF]++;
+
+	for (int digit = 0; digit < 8; digit++) {
+		uint32_t* histogram = histograms[digit];
+
+		if (histogram[(packets[0].key >> (digit * 8)) & 0xFF] == count)
+			continue;
+
+		uint32_t offset = 0;
+		for (int bucket = 0; bucket < 256; bucket++) {
+			uint32_t size = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += size;
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			uint32_t index = order[i];
+			tempOrder[histogram[(packets[index].key >> (digit * 8)) & 0xFF]++] = index;
+		}
+
+		order.swap(tempOrder);
+	}
+}
+
+size_t RenderCommandBuffer::GetCount() const {
+	return packets.size();
+}
+
+const DrawPacket& RenderCommandBuffer::GetSorted(size_t index) const {
+	return packets[order[index]];
+}
+
+const std::vector<DrawPacket>& RenderCommandBuffer::GetPackets() const {
+	return packets;
+}
+
+CountingCommandExecutor::CountingCommandExecutor() {
+	statistics = {};
+}
+
+void CountingCommandExecutor::Execute(const RenderCommandBuffer& commands) {
+	statistics = {};
+
+	const DrawPacket* previous = nullptr;
+	for (size_t i = 0; i < commands.GetCount(); i++) {
+		const DrawPacket& packet = commands.GetSorted(i);
+
+		if (!previous || packet.vertexShader != previous->vertexShader || packet.pixelShader != previous->pixelShader)
+			statistics.shaderChanges++;
+		if (!previous || packet.inputLayout != previous->inputLayout)
+			statistics.layoutChanges++;
+		if (!previous || packet.rasterizerState != previous->rasterizerState)
+			statistics.rasterizerChanges++;
+		if (!previous || packet.vertexBuffer != previous->vertexBuffer || packet.vertexStride != previous->vertexStride)
+			statistics.vertexBufferChanges++;
+		if (!previous || packet.indexBuffer != previous->indexBuffer || packet.indexFormat != previous->indexFormat)
+			statistics.indexBufferChanges++;
+		if (packet.constantBuffer)
+			statistics.constantUploads++;
+
+		statistics.draws++;
+		previous = &packet;
+	}
+}
+
+const IRenderCommandExecutor::Statistics& CountingCommandExecutor::GetStatistics() const {
+	return statistics;
+}
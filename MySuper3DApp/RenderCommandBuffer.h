@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// DXGI formats of "DrawPacket::indexFormat", without the DXGI headers
+static const uint32_t INDEX_FORMAT_R32_UINT = 42;
+static const uint32_t INDEX_FORMAT_R16_UINT = 57;
+
+/*
+* One draw call with all its state
+* Plain data: resources are opaque pointers, so packets can be recorded, sorted and counted without a device
+*/
+struct DrawPacket {
+	static const uint32_t TRANSIENT_VERTICES = 1; // "vertexBuffer" is CPU memory of this frame, GPU executors upload it
+
+	uint64_t key; // Sort key, made by RenderCommandBuffer::Sort()
+	uint32_t layer; // Key fields set by the recorder
+	uint32_t pass;
+	float depth; // View-space depth, [0; 1] is the view volume
+	uint32_t flags;
+
+	const void* vertexShader;
+	const void* pixelShader;
+	const void* inputLayout;
+	const void* rasterizerState;
+	const void* vertexBuffer;
+	const void* indexBuffer;
+	const void* constantBuffer; // Receives "constants"
+
+	uint32_t vertexStride;
+	uint32_t vertexCount; // Vertices in "vertexBuffer"
+	uint32_t indexCount;
+	uint32_t startIndex;
+	int32_t baseVertex;
+	uint32_t indexFormat; // DXGI format of the indices
+
+	float constants[16]; // World matrix (transposed for HLSL)
+};
+
+/*
+* Per-frame list of draw packets
+* Components record packets, Sort() makes their keys and orders them with an LSD radix sort,
+* an executor replays them in that order
+* Key layout (high to low bits): layer 4 | pass 4 | shader 16 | layout 8 | buffer 16 | depth 16
+*/
+class RenderCommandBuffer {
+	std::vector<DrawPacket> packets;
+	std::vector<uint32_t> order; // Packet indices in sorted order
+	std::vector<uint32_t> tempOrder;
+	std::unordered_map<const void*, uint32_t> resourceIds; // Dense ids of the resources of the sorted frame
+
+	uint32_t GetResourceId(const void* resource); // Small id of a resource pointer (0 for nullptr)
+
+public:
+	static uint64_t MakeKey(uint32_t layer, uint32_t pass, uint32_t shader, uint32_t layout, uint32_t buffer, float depth);
+
+	void Reset();
+	DrawPacket& Add(); // Packet is zeroed
+	void Append(const RenderCommandBuffer& other); // Merge packets recorded on another thread, before Sort()
+
+	void Sort();
+
+	size_t GetCount() const;
+	const DrawPacket& GetSorted(size_t index) const; // Valid after Sort()
+	const std::vector<DrawPacket>& GetPackets() const; // In recording order
+};
+
+/*
+* Replays a sorted command buffer
+*/
+class IRenderCommandExecutor {
+public:
+	struct Statistics {
+		unsigned int draws;
+		unsigned int shaderChanges; // Vertex or pixel shader bound
+		unsigned int layoutChanges;
+		unsigned int rasterizerChanges;
+		unsigned int vertexBufferChanges;
+		unsigned int indexBufferChanges;
+		unsigned int constantUploads;
+	};
+
+	virtual ~IRenderCommandExecutor() = default;
+
+	virtual void Execute(const RenderCommandBuffer& commands) = 0;
+	virtual const Statistics& GetStatistics() const = 0; // Of the last Execute()
+};
+
+/*
+* Executor without a device for headless runs and tests
+* Counts draws and the state changes a real backend would issue
+*/
+class CountingCommandExecutor : public IRenderCommandExecutor {
+	Statistics statistics;
+
+public:
+	CountingCommandExecutor();
+
+	void Execute(const RenderCommandBuffer& commands) override;
+	const Statistics& GetStatistics() const override;
+};
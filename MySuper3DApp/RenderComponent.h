@@ -1,48 +1,40 @@
 #pragma once
 #include "Game.h"
 #include "GameObjectComponent.h"
+#include "TransformSystem.h"
+#include "VertexLayout.h"
+#include "RenderMesh.h"
 
 class Game;
 
 class RenderComponent : public GameObjectComponent {
 protected:
-	Microsoft::WRL::ComPtr<ID3D11InputLayout> layout;
-	Microsoft::WRL::ComPtr<ID3D11PixelShader> pixelShader;
-	Microsoft::WRL::ComPtr<ID3DBlob> pixelShaderByteCode;
-	Microsoft::WRL::ComPtr<ID3D11VertexShader> vertexShader;
-	Microsoft::WRL::ComPtr<ID3DBlob> vertexShaderByteCode;
+	std::shared_ptr<RenderMesh> mesh; // Resources in the graphics backend (nullptr before Initialize() or on error)
+	TransformSystem* transforms; // World matrix of the rendering object (nullptr - identity)
+	TransformId transform;
 
-	std::shared_ptr<CD3D11_RASTERIZER_DESC> rastDesc;
-	Microsoft::WRL::ComPtr<ID3D11RasterizerState> rastState;
-
-	std::shared_ptr<D3D11_BUFFER_DESC> vertexBufDesc;
-	std::shared_ptr<D3D11_SUBRESOURCE_DATA> vertexData;
-	Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuf;
+	std::vector<int> indeces; // Fill before Initialize()
 
-	std::shared_ptr<D3D11_BUFFER_DESC> indexBufDesc;
-	std::shared_ptr<D3D11_SUBRESOURCE_DATA> indexData;
-	Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuf;
+	VertexLayout vertexLayout; // Format of the vertex buffer, "points" are packed into it
 
-	std::shared_ptr<D3D11_BUFFER_DESC> constBufDesc;
-	std::shared_ptr<D3D11_SUBRESOURCE_DATA> constData;
-	Microsoft::WRL::ComPtr<ID3D11Buffer> constBuf;
-	std::shared_ptr<DirectX::SimpleMath::Vector4> renderOffset; // For offset of rendering object
+	DirectX::BoundingBox localBounds; // Of the positions in "points"
 
-	std::vector<int> indeces; // Fill before Initialize()
-
-	UINT strides[1];
-	UINT offsets[1];
+	DirectX::SimpleMath::Matrix GetWorldMatrix() const; // Interpolated for the recorded frame
+	void ComputeBounds(); // "localBounds" from "points"
 
 public:
 	std::vector<DirectX::XMFLOAT4> points; // Fill before Initialize()
 
 	RenderComponent();
-	RenderComponent(std::shared_ptr<DirectX::SimpleMath::Vector4> renderOffset);
+	RenderComponent(TransformSystem* transforms, TransformId transform);
+
+	void SetVertexLayout(const VertexLayout& vertexLayout); // Call before Initialize()
 
 	void Initialize();
 	void Update();
 	void FixedUpdate();
 	void Draw();
+	bool GetBounds(DirectX::BoundingBox& localBounds, DirectX::SimpleMath::Matrix& world) override;
 	void Reload();
 	void DestroyResources();
 };
@@ -0,0 +1,42 @@
+#include "RenderMesh.h"
+#include "RenderCommandBuffer.h"
+
+RenderMesh::RenderMesh() {
+	vertexShader = nullptr;
+	pixelShader = nullptr;
+	inputLayout = nullptr;
+	rasterizerState = nullptr;
+	vertexBuffer = nullptr;
+	indexBuffer = nullptr;
+	constantBuffer = nullptr;
+
+	vertexStride = 0;
+	vertexCount = 0;
+	indexCount = 0;
+	indexFormat = INDEX_FORMAT_R32_UINT;
+}
+
+void RenderMesh::FillPacket(DrawPacket& packet) const {
+	packet.vertexShader = vertexShader;
+	packet.pixelShader = pixelShader;
+	packet.inputLayout = inputLayout;
+	packet.rasterizerState = rasterizerState;
+	packet.vertexBuffer = vertexBuffer;
+	packet.indexBuffer = indexBuffer;
+	packet.constantBuffer = constantBuffer;
+	packet.vertexStride = vertexStride;
+	packet.vertexCount = vertexCount;
+	packet.indexCount = indexCount;
+	packet.indexFormat = indexFormat;
+}
+
+CpuRenderMesh::CpuRenderMesh(const MeshDesc& desc) {
+	vertices.assign(desc.vertices, desc.vertices + desc.vertexCount * 8);
+	indices.assign(desc.indices, desc.indices + desc.indexCount);
+
+	vertexBuffer = vertices.data();
+	indexBuffer = indices.data();
+	vertexStride = sizeof(float) * 8;
+	vertexCount = static_cast<uint32_t>(desc.vertexCount);
+	indexCount = static_cast<uint32_t>(desc.indexCount);
+}
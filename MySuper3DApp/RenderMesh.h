@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "VertexLayout.h"
+
+struct DrawPacket;
+
+/*
+* Geometry of a render component for GraphicsBackend::CreateMesh()
+* Vertices are position and color pairs (two float4), as in "RenderComponent::points"
+*/
+struct MeshDesc {
+	const float* vertices;
+	size_t vertexCount;
+	const int* indices;
+	size_t indexCount;
+	VertexLayout vertexLayout; // Format of the vertex buffer, "vertices" are packed into it
+};
+
+/*
+* Resources of one mesh in a graphics backend
+* Pointers are opaque for the engine, only the command executor of the same backend uses them
+*/
+class RenderMesh {
+public:
+	const void* vertexShader;
+	const void* pixelShader;
+	const void* inputLayout;
+	const void* rasterizerState;
+	const void* vertexBuffer;
+	const void* indexBuffer;
+	const void* constantBuffer;
+
+	uint32_t vertexStride;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	uint32_t indexFormat; // DXGI format of the indices
+
+	RenderMesh();
+	virtual ~RenderMesh() = default;
+
+	void FillPacket(DrawPacket& packet) const; // Everything except the key fields and the constants
+};
+
+/*
+* Mesh in CPU memory for backends without a GPU
+* Vertices are "SoftwareVertex", indices are 32-bit
+*/
+class CpuRenderMesh : public RenderMesh {
+	std::vector<float> vertices;
+	std::vector<uint32_t> indices;
+
+public:
+	CpuRenderMesh(const MeshDesc& desc);
+};
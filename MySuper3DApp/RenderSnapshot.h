@@ -0,0 +1,18 @@
+#pragma once
+#include "RenderCommandBuffer.h"
+#include "SpriteBatcher.h"
+
+/*
+* Immutable render data of one frame: sorted draw packets with their world matrices and finished sprite batches
+* Recorded by the simulation thread, submitted by the render thread (see "TripleBuffer"),
+* which never reads game objects or transforms
+*/
+struct RenderSnapshot {
+	RenderCommandBuffer commands;
+	SpriteBatcher sprites; // Vertex stream of the sprite packets in "commands"
+	float alpha; // Interpolation factor the frame was recorded with
+	unsigned int frame; // Number of the simulation frame
+	long long frameStart; // Profiler time of the frame start, the frame ends when it is presented
+
+	RenderSnapshot() : alpha(0), frame(0), frameStart(0) {}
+};
@@ -0,0 +1,121 @@
+#include "ShaderCache.h"
+#include "Fnv1a.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+// Terminating zero separates fields, so "ab" + "c" and "a" + "bc" give different keys
+static void HashString(uint64_t& hash, const std::string& text) {
+	Fnv1a::Add(hash, text.c_str(), text.size() + 1);
+}
+
+ShaderCache::ShaderCache(std::shared_ptr<IShaderCompiler> compiler, const std::string& cacheDirectory) {
+	this->compiler = compiler;
+	this->cacheDirectory = cacheDirectory;
+	statistics = {};
+}
+
+/*
+* 64-bit FNV-1a of everything that affects the bytecode
+* "#include" files are not followed, shaders of this project don't use them
+*/
+uint64_t ShaderCache::ComputeKey(const std::string& source, const ShaderDesc& desc) {
+	uint64_t hash = Fnv1a::OFFSET;
+
+	HashString(hash, source);
+	HashString(hash, desc.entryPoint);
+	HashString(hash, desc.profile);
+
+	for (const auto& define : desc.defines) {
+		HashString(hash, define.first);
+		HashString(hash, define.second);
+	}
+
+	Fnv1a::Add(hash, &desc.flags, sizeof(desc.flags));
+
+	return hash;
+}
+
+const std::string* ShaderCache::GetSource(const std::string& path) {
+	auto found = sources.find(path);
+	if (found != sources.end())
+		return &found->second;
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return nullptr;
+
+	std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return &(sources[path] = std::move(source));
+}
+
+std::string ShaderCache::GetBlobPath(uint64_t key) const {
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.cso", static_cast<unsigned long long>(key));
+	return cacheDirectory + "/" + name;
+}
+
+std::shared_ptr<const ShaderBytecode> ShaderCache::GetBytecode(const ShaderDesc& desc, std::string& errors, uint64_t* key) {
+	const std::string* source = GetSource(desc.path);
+	if (!source) {
+		errors = "Missing shader file: " + desc.path;
+		statistics.failures++;
+		return nullptr;
+	}
+
+	uint64_t sourceKey = ComputeKey(*source, desc);
+	if (key)
+		*key = sourceKey;
+
+	auto found = blobs.find(sourceKey);
+	if (found != blobs.end()) {
+		statistics.memoryHits++;
+		return found->second;
+	}
+
+	auto bytecode = std::make_shared<ShaderBytecode>();
+
+	if (!cacheDirectory.empty()) {
+		std::ifstream file(GetBlobPath(sourceKey), std::ios::binary);
+		if (file) {
+			bytecode->assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			if (!bytecode->empty()) {
+				statistics.diskHits++;
+				blobs[sourceKey] = bytecode;
+				return bytecode;
+			}
+		}
+	}
+
+	if (!compiler || !compiler->Compile(*source, desc, *bytecode, errors)) {
+		statistics.failures++;
+		return nullptr;
+	}
+
+	statistics.compiles++;
+	blobs[sourceKey] = bytecode;
+
+	// Written to a temporary file first, so a crash can't leave a truncated blob under the real name
+	if (!cacheDirectory.empty()) {
+		std::string blobPath = GetBlobPath(sourceKey);
+		std::string tempPath = blobPath + ".tmp";
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+			if (file)
+				file.write(reinterpret_cast<const char*>(bytecode->data()), bytecode->size());
+		}
+		std::remove(blobPath.c_str());
+		std::rename(tempPath.c_str(), blobPath.c_str());
+	}
+
+	return bytecode;
+}
+
+void ShaderCache::Clear() {
+	blobs.clear();
+	sources.clear();
+}
+
+const ShaderCache::Statistics& ShaderCache::GetStatistics() const {
+	return statistics;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using ShaderBytecode = std::vector<unsigned char>;
+
+/*
+* Everything that changes the compiled bytecode, except the source text
+*/
+struct ShaderDesc {
+	std::string path; // Source file
+	std::string entryPoint;
+	std::string profile; // "vs_5_0", "ps_5_0", ...
+	std::vector<std::pair<std::string, std::string>> defines;
+	unsigned int flags; // Compiler flags
+};
+
+/*
+* Source to bytecode compiler
+* Hidden behind an interface, so the cache works without "Direct3D" (and with a stub compiler)
+*/
+class IShaderCompiler {
+public:
+	virtual ~IShaderCompiler() = default;
+
+	virtual bool Compile(const std::string& source, const ShaderDesc& desc, ShaderBytecode& bytecode, std::string& errors) = 0;
+};
+
+/*
+* Content-addressed shader bytecode cache
+* Key is a hash of source + entry point + profile + defines + flags
+* Lookup order: memory table, blob file in the cache directory, compiler
+*/
+class ShaderCache {
+public:
+	struct Statistics {
+		unsigned int memoryHits;
+		unsigned int diskHits;
+		unsigned int compiles;
+		unsigned int failures;
+	};
+
+private:
+	std::shared_ptr<IShaderCompiler> compiler;
+	std::string cacheDirectory; // Empty - no disk cache
+	std::unordered_map<uint64_t, std::shared_ptr<const ShaderBytecode>> blobs;
+	std::unordered_map<std::string, std::string> sources; // Source text by path, read once
+	Statistics statistics;
+
+	const std::string* GetSource(const std::string& path);
+	std::string GetBlobPath(uint64_t key) const;
+
+public:
+	ShaderCache(std::shared_ptr<IShaderCompiler> compiler, const std::string& cacheDirectory);
+
+	static uint64_t ComputeKey(const std::string& source, const ShaderDesc& desc);
+
+	// Returns nullptr if the source is missing or doesn't compile, "errors" gets the reason
+	std::shared_ptr<const ShaderBytecode> GetBytecode(const ShaderDesc& desc, std::string& errors, uint64_t* key = nullptr);
+
+	void Clear(); // Forget the memory table and sources (files are kept)
+
+	const Statistics& GetStatistics() const;
+};
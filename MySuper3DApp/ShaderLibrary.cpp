@@ -0,0 +1,77 @@
+#include "ShaderLibrary.h"
+#include <d3dcompiler.h>
+#include <cstdio>
+
+// Creation errors have no compiler output, the HRESULT is the reason
+static std::string CreationError(const char* function, HRESULT res, const ShaderDesc& desc) {
+	char code[16];
+	snprintf(code, sizeof(code), "0x%08lx", static_cast<unsigned long>(res));
+	return std::string(function) + " failed with " + code + ": " + desc.path + " (" + desc.entryPoint + ", " + desc.profile + ")";
+}
+
+ShaderLibrary::ShaderLibrary(Microsoft::WRL::ComPtr<ID3D11Device> device, std::shared_ptr<ShaderCache> cache) {
+	this->device = device;
+	this->cache = cache;
+}
+
+Microsoft::WRL::ComPtr<ID3D11VertexShader> ShaderLibrary::GetVertexShader(const ShaderDesc& desc, std::string& errors, std::shared_ptr<const ShaderBytecode>* bytecode) {
+	uint64_t key = 0;
+	std::shared_ptr<const ShaderBytecode> code = cache->GetBytecode(desc, errors, &key);
+	if (!code)
+		return nullptr;
+
+	// Failed shaders are not stored, the next call tries again
+	auto found = vertexShaders.find(key);
+	if (found == vertexShaders.end()) {
+		VertexShaderEntry entry;
+		HRESULT res = device->CreateVertexShader(code->data(), code->size(), nullptr, entry.shader.GetAddressOf());
+		if (FAILED(res)) {
+			errors = CreationError("CreateVertexShader", res, desc);
+			return nullptr;
+		}
+
+		entry.bytecode = code;
+		found = vertexShaders.emplace(key, entry).first;
+	}
+
+	if (bytecode)
+		*bytecode = found->second.bytecode;
+
+	return found->second.shader;
+}
+
+Microsoft::WRL::ComPtr<ID3D11PixelShader> ShaderLibrary::GetPixelShader(const ShaderDesc& desc, std::string& errors) {
+	uint64_t key = 0;
+	std::shared_ptr<const ShaderBytecode> code = cache->GetBytecode(desc, errors, &key);
+	if (!code)
+		return nullptr;
+
+	auto found = pixelShaders.find(key);
+	if (found != pixelShaders.end())
+		return found->second;
+
+	Microsoft::WRL::ComPtr<ID3D11PixelShader> shader;
+	HRESULT res = device->CreatePixelShader(code->data(), code->size(), nullptr, shader.GetAddressOf());
+	if (FAILED(res)) {
+		errors = CreationError("CreatePixelShader", res, desc);
+		return nullptr;
+	}
+
+	pixelShaders[key] = shader;
+	return shader;
+}
+
+std::shared_ptr<ShaderCache> ShaderLibrary::GetCache() {
+	return cache;
+}
+
+/*
+* Debug information only in debug builds, release builds get optimized shaders
+*/
+unsigned int ShaderLibrary::GetDefaultFlags() {
+#ifdef _DEBUG
+	return D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#else
+	return D3DCOMPILE_OPTIMIZATION_LEVEL3;
+#endif
+}
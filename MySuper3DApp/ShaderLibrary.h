@@ -0,0 +1,34 @@
+#pragma once
+#include <wrl.h>
+#include <d3d11.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "ShaderCache.h"
+
+/*
+* Shader objects shared by all components
+* Bytecode comes from "ShaderCache", so every shader is compiled (or loaded) and created once
+*/
+class ShaderLibrary {
+	struct VertexShaderEntry {
+		Microsoft::WRL::ComPtr<ID3D11VertexShader> shader;
+		std::shared_ptr<const ShaderBytecode> bytecode; // Needed for input layouts
+	};
+
+	Microsoft::WRL::ComPtr<ID3D11Device> device;
+	std::shared_ptr<ShaderCache> cache;
+	std::unordered_map<uint64_t, VertexShaderEntry> vertexShaders; // By cache key
+	std::unordered_map<uint64_t, Microsoft::WRL::ComPtr<ID3D11PixelShader>> pixelShaders;
+
+public:
+	ShaderLibrary(Microsoft::WRL::ComPtr<ID3D11Device> device, std::shared_ptr<ShaderCache> cache);
+
+	// nullptr on error, the message is in "errors", failures are not cached
+	Microsoft::WRL::ComPtr<ID3D11VertexShader> GetVertexShader(const ShaderDesc& desc, std::string& errors, std::shared_ptr<const ShaderBytecode>* bytecode = nullptr);
+	Microsoft::WRL::ComPtr<ID3D11PixelShader> GetPixelShader(const ShaderDesc& desc, std::string& errors);
+
+	std::shared_ptr<ShaderCache> GetCache();
+
+	static unsigned int GetDefaultFlags();
+};
@@ -9,7 +9,7 @@ struct VS_IN {
 };
 
 struct ConstData {
-    float4 offset;
+    float4x4 world;
 };
 
 cbuffer ConstBuf : register(b0) {
@@ -25,7 +25,7 @@ float4 PSMain(PS_IN input) : SV_Target {
 PS_IN VSMain(VS_IN input) {
     PS_IN output = (PS_IN) 0;
 	
-    output.pos = input.pos + constData.offset;
+    output.pos = mul(input.pos, constData.world);
     output.col = input.col;
 	
     return output;
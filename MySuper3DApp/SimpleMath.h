@@ -14,6 +14,15 @@
 #include <dxgi1_2.h>
 #endif
 
+#ifndef _WIN32
+// Win32 types of the rectangle and viewport helpers
+struct RECT { long left; long top; long right; long bottom; };
+typedef unsigned int UINT;
+#ifndef __cdecl
+#define __cdecl
+#endif
+#endif
+
 #include <cassert>
 #include <cstddef>
 #include <cstring>
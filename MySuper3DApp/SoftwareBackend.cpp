@@ -0,0 +1,87 @@
+#include "SoftwareBackend.h"
+
+SoftwareGraphics::SoftwareGraphics(int width, int height, JobSystem* jobSystem, const std::string& framePath) {
+	rasterizer = std::make_shared<SoftwareRasterizer>(width, height, jobSystem);
+	this->framePath = framePath;
+	totals = {};
+}
+
+/*
+* Clear with the same color as the "Direct3D 11" backend
+*/
+void SoftwareGraphics::PrepareFrame() {
+	float backgroundColor[] = { 0.18f, 0.55f, 0.34f, 1.0f };
+	rasterizer->BeginFrame(backgroundColor);
+}
+
+void SoftwareGraphics::EndFrame() {
+	rasterizer->EndFrame();
+
+	const SoftwareRasterizer::Statistics& statistics = rasterizer->GetStatistics();
+	totals.frames++;
+	totals.triangles += statistics.triangles;
+	totals.pixels += statistics.pixels;
+	totals.seconds += statistics.seconds;
+}
+
+/*
+* No-op: there is no display to wait for, frames are paced by "FramePacer" only
+*/
+void SoftwareGraphics::SetVSync(bool vsync) {
+
+}
+
+void SoftwareGraphics::DestroyResources() {
+	if (!framePath.empty() && totals.frames > 0)
+		rasterizer->WritePPM(framePath);
+}
+
+/*
+* Meshes stay in CPU memory, the rasterizer reads "SoftwareVertex" directly
+*/
+std::shared_ptr<RenderMesh> SoftwareGraphics::CreateMesh(const MeshDesc& desc) {
+	return std::make_shared<CpuRenderMesh>(desc);
+}
+
+std::shared_ptr<IRenderCommandExecutor> SoftwareGraphics::CreateCommandExecutor() {
+	return std::make_shared<SoftwareCommandExecutor>(rasterizer);
+}
+
+std::shared_ptr<SoftwareRasterizer> SoftwareGraphics::GetRasterizer() {
+	return rasterizer;
+}
+
+const SoftwareGraphics::Totals& SoftwareGraphics::GetTotals() const {
+	return totals;
+}
+
+SoftwareCommandExecutor::SoftwareCommandExecutor(std::shared_ptr<SoftwareRasterizer> rasterizer) {
+	this->rasterizer = rasterizer;
+}
+
+void SoftwareCommandExecutor::Execute(const RenderCommandBuffer& commands) {
+	counter.Execute(commands);
+
+	for (size_t i = 0; i < commands.GetCount(); i++) {
+		const DrawPacket& packet = commands.GetSorted(i);
+		if (!packet.vertexBuffer || !packet.indexBuffer)
+			continue;
+
+		// Constants hold the transposed world matrix
+		float world[16];
+		for (int row = 0; row < 4; row++)
+			for (int column = 0; column < 4; column++)
+				world[row * 4 + column] = packet.constants[column * 4 + row];
+
+		const SoftwareVertex* vertices = static_cast<const SoftwareVertex*>(packet.vertexBuffer);
+
+		if (packet.indexFormat == INDEX_FORMAT_R16_UINT)
+			rasterizer->DrawIndexed16(vertices, packet.vertexCount, static_cast<const uint16_t*>(packet.indexBuffer) + packet.startIndex, packet.indexCount, packet.baseVertex, world);
+		else
+			rasterizer->DrawIndexed(vertices, packet.vertexCount, static_cast<const uint32_t*>(packet.indexBuffer) + packet.startIndex, packet.indexCount, packet.baseVertex, world);
+	}
+}
+
+const IRenderCommandExecutor::Statistics& SoftwareCommandExecutor::GetStatistics() const {
+	return counter.GetStatistics();
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <memory>
+#include <string>
+#include "GraphicsBackend.h"
+#include "RenderCommandBuffer.h"
+#include "SoftwareRasterizer.h"
+
+/*
+* Graphics backend rendering on the CPU with "SoftwareRasterizer"
+* For machines without GPU: golden images and throughput runs
+* The last frame is written to a PPM file on DestroyResources()
+*/
+class SoftwareGraphics : public GraphicsBackend {
+public:
+	struct Totals {
+		unsigned int frames;
+		unsigned long long triangles;
+		unsigned long long pixels;
+		double seconds;
+	};
+
+protected:
+	std::shared_ptr<SoftwareRasterizer> rasterizer;
+	std::string framePath; // Empty - don't write
+	Totals totals;
+
+public:
+	SoftwareGraphics(int width, int height, JobSystem* jobSystem, const std::string& framePath);
+
+	void PrepareFrame() override;
+	void EndFrame() override;
+	void SetVSync(bool vsync) override;
+	void DestroyResources() override;
+
+	std::shared_ptr<RenderMesh> CreateMesh(const MeshDesc& desc) override;
+	std::shared_ptr<IRenderCommandExecutor> CreateCommandExecutor() override;
+
+	std::shared_ptr<SoftwareRasterizer> GetRasterizer();
+	const Totals& GetTotals() const;
+};
+
+/*
+* Replays draw packets on "SoftwareRasterizer"
+* Vertex and index buffers of packets must point to CPU memory ("SoftwareVertex" and 32 or 16-bit indices),
+* so transient vertices of sprite batches are drawn in place
+*/
+class SoftwareCommandExecutor : public IRenderCommandExecutor {
+	std::shared_ptr<SoftwareRasterizer> rasterizer;
+	CountingCommandExecutor counter; // Statistics are the same as a GPU backend would have
+
+public:
+	SoftwareCommandExecutor(std::shared_ptr<SoftwareRasterizer> rasterizer);
+
+	void Execute(const RenderCommandBuffer& commands) override;
+	const Statistics& GetStatistics() const override;
+};
@@ -0,0 +1,338 @@
+#include "SoftwareRasterizer.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFTWARE_RASTERIZER_SSE2
+#include <emmintrin.h>
+#endif
+
+static uint32_t PackColor(const float color[4]) {
+	uint32_t packed = 0;
+	for (int i = 0; i < 4; i++) {
+		float value = std::min(std::max(color[i], 0.0f), 1.0f);
+		packed |= static_cast<uint32_t>(value * 255.0f + 0.5f) << (i * 8);
+	}
+	return packed;
+}
+
+SoftwareRasterizer::SoftwareRasterizer(int width, int height, JobSystem* jobSystem) {
+	this->width = width;
+	this->height = height;
+	this->jobSystem = jobSystem;
+
+	tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+	tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+	framebuffer.resize(static_cast<size_t>(width) * height);
+	bins.resize(tilesX * tilesY);
+	tilePixels.resize(tilesX * tilesY);
+	clearColor = 0;
+	statistics = {};
+}
+
+void SoftwareRasterizer::BeginFrame(const float clearColor[4]) {
+	this->clearColor = PackColor(clearColor);
+	triangles.clear();
+}
+
+/*
+* Vertex stage and triangle setup
+* No clipping: triangles with a vertex behind the camera (w <= 0) are dropped,
+* the rest are limited by the screen clamped bounding box
+*/
+void SoftwareRasterizer::DrawIndexed(const SoftwareVertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount, int baseVertex, const float* world) {
+	for (size_t i = 0; i + 2 < indexCount; i += 3) {
+		float positions[3][4];
+		const float* colors[3];
+		bool valid = true;
+
+		for (int corner = 0; corner < 3; corner++) {
+			size_t index = static_cast<size_t>(static_cast<int64_t>(indices[i + corner]) + baseVertex);
+			if (index >= vertexCount) {
+				valid = false;
+				break;
+			}
+
+			const float* p = vertices[index].position;
+			float* out = positions[corner];
+			if (world) {
+				for (int column = 0; column < 4; column++)
+					out[column] = p[0] * world[column] + p[1] * world[4 + column] + p[2] * world[8 + column] + p[3] * world[12 + column];
+			}
+			else
+				std::copy(p, p + 4, out);
+
+			colors[corner] = vertices[index].color;
+		}
+
+		if (valid)
+			SetupTriangle(positions[0], positions[1], positions[2], colors[0], colors[1], colors[2]);
+	}
+}
+
+void SoftwareRasterizer::DrawIndexed16(const SoftwareVertex* vertices, size_t vertexCount, const uint16_t* indices, size_t indexCount, int baseVertex, const float* world) {
+	// Widen in small blocks, so setup code is shared with 32-bit indices
+	uint32_t wide[96];
+	for (size_t first = 0; first < indexCount; first += 96) {
+		size_t count = std::min<size_t>(96, indexCount - first);
+		for (size_t i = 0; i < count; i++)
+			wide[i] = indices[first + i];
+		DrawIndexed(vertices, vertexCount, wide, count, baseVertex, world);
+	}
+}
+
+void SoftwareRasterizer::SetupTriangle(const float* p0, const float* p1, const float* p2, const float* c0, const float* c1, const float* c2) {
+	if (p0[3] <= 0 || p1[3] <= 0 || p2[3] <= 0)
+		return;
+
+	// Perspective divide and viewport transform (y goes down on the screen)
+	float x[3], y[3];
+	const float* p[3] = { p0, p1, p2 };
+	for (int i = 0; i < 3; i++) {
+		x[i] = (p[i][0] / p[i][3] * 0.5f + 0.5f) * width;
+		y[i] = (0.5f - p[i][1] / p[i][3] * 0.5f) * height;
+	}
+
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (area == 0 || std::isnan(area))
+		return;
+
+	// Cull mode is none: the other winding is swapped, so edge functions are always positive inside
+	const float* colors[3] = { c0, c1, c2 };
+	if (area < 0) {
+		std::swap(x[1], x[2]);
+		std::swap(y[1], y[2]);
+		std::swap(colors[1], colors[2]);
+		area = -area;
+	}
+
+	Triangle triangle;
+	triangle.minX = std::max(0, static_cast<int>(std::floor(std::min({ x[0], x[1], x[2] }))));
+	triangle.minY = std::max(0, static_cast<int>(std::floor(std::min({ y[0], y[1], y[2] }))));
+	triangle.maxX = std::min(width, static_cast<int>(std::ceil(std::max({ x[0], x[1], x[2] }))) + 1);
+	triangle.maxY = std::min(height, static_cast<int>(std::ceil(std::max({ y[0], y[1], y[2] }))) + 1);
+	if (triangle.minX >= triangle.maxX || triangle.minY >= triangle.maxY)
+		return;
+
+	// Edge i is opposite to vertex i, so its value divided by the area is the barycentric weight of vertex i
+	for (int i = 0; i < 3; i++) {
+		int from = (i + 1) % 3;
+		int to = (i + 2) % 3;
+
+		triangle.edgeA[i] = y[from] - y[to];
+		triangle.edgeB[i] = x[to] - x[from];
+		triangle.edgeC[i] = x[from] * y[to] - x[to] * y[from];
+
+		// Top edge: horizontal with the inside below, left edge: the inside on the right going down
+		triangle.topLeft[i] = (triangle.edgeA[i] == 0 && triangle.edgeB[i] < 0) || triangle.edgeA[i] > 0;
+
+		std::copy(colors[i], colors[i] + 4, triangle.color[i]);
+	}
+
+	triangle.inverseArea = 1.0f / area;
+	triangles.push_back(triangle);
+}
+
+/*
+* All triangles touching the tile in submission order
+* Pixels are processed 4 in a row with SSE2 when available
+*/
+void SoftwareRasterizer::RasterizeTile(int tile) {
+	int tileX = (tile % tilesX) * TILE_SIZE;
+	int tileY = (tile / tilesX) * TILE_SIZE;
+	int tileMaxX = std::min(tileX + TILE_SIZE, width);
+	int tileMaxY = std::min(tileY + TILE_SIZE, height);
+
+	for (int y = tileY; y < tileMaxY; y++)
+		std::fill(framebuffer.begin() + static_cast<size_t>(y) * width + tileX, framebuffer.begin() + static_cast<size_t>(y) * width + tileMaxX, clearColor);
+
+	unsigned long long pixels = 0;
+
+	for (uint32_t index : bins[tile]) {
+		const Triangle& triangle = triangles[index];
+
+		int minX = std::max(triangle.minX, tileX) & ~3; // Start of a 4 pixel group
+		int minY = std::max(triangle.minY, tileY);
+		int maxX = std::min(triangle.maxX, tileMaxX);
+		int maxY = std::min(triangle.maxY, tileMaxY);
+
+#ifdef SOFTWARE_RASTERIZER_SSE2
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 scale = _mm_set1_ps(255.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 steps = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f); // Pixel centers of a group
+
+		__m128 edgeA[3], edgeB[3], edgeC[3], topLeft[3];
+		for (int e = 0; e < 3; e++) {
+			edgeA[e] = _mm_set1_ps(triangle.edgeA[e]);
+			edgeB[e] = _mm_set1_ps(triangle.edgeB[e]);
+			edgeC[e] = _mm_set1_ps(triangle.edgeC[e]);
+			topLeft[e] = _mm_castsi128_ps(_mm_set1_epi32(triangle.topLeft[e] ? -1 : 0));
+		}
+		__m128 inverseArea = _mm_set1_ps(triangle.inverseArea);
+
+		for (int y = minY; y < maxY; y++) {
+			uint32_t* row = framebuffer.data() + static_cast<size_t>(y) * width;
+			__m128 pixelY = _mm_set1_ps(y + 0.5f);
+
+			for (int x = minX; x < maxX; x += 4) {
+				__m128 pixelX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), steps);
+
+				__m128 mask = _mm_castsi128_ps(_mm_set1_epi32(-1));
+				__m128 weights[3];
+				for (int e = 0; e < 3; e++) {
+					__m128 value = _mm_add_ps(_mm_add_ps(_mm_mul_ps(edgeA[e], pixelX), _mm_mul_ps(edgeB[e], pixelY)), edgeC[e]);
+					__m128 inside = _mm_or_ps(_mm_cmpgt_ps(value, zero), _mm_and_ps(_mm_cmpeq_ps(value, zero), topLeft[e]));
+					mask = _mm_and_ps(mask, inside);
+					weights[e] = _mm_mul_ps(value, inverseArea);
+				}
+
+				// Groups overlapping the right edge of the tile or screen
+				int valid = maxX - x < 4 ? (1 << (maxX - x)) - 1 : 0xF;
+				int bits = _mm_movemask_ps(mask) & valid;
+				if (!bits)
+					continue;
+
+				__m128i packed = _mm_setzero_si128();
+				for (int channel = 0; channel < 4; channel++) {
+					__m128 value = _mm_add_ps(_mm_add_ps(
+						_mm_mul_ps(weights[0], _mm_set1_ps(triangle.color[0][channel])),
+						_mm_mul_ps(weights[1], _mm_set1_ps(triangle.color[1][channel]))),
+						_mm_mul_ps(weights[2], _mm_set1_ps(triangle.color[2][channel])));
+					value = _mm_min_ps(_mm_max_ps(value, zero), one);
+					__m128i bytes = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, scale), half));
+					packed = _mm_or_si128(packed, _mm_slli_epi32(bytes, channel * 8));
+				}
+
+				if (bits == 0xF && x + 4 <= width) {
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), packed);
+					pixels += 4;
+				}
+				else {
+					uint32_t colors[4];
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(colors), packed);
+					for (int i = 0; i < 4; i++) {
+						if (bits & (1 << i)) {
+							row[x + i] = colors[i];
+							pixels++;
+						}
+					}
+				}
+			}
+		}
+#else
+		for (int y = minY; y < maxY; y++) {
+			uint32_t* row = framebuffer.data() + static_cast<size_t>(y) * width;
+			float pixelY = y + 0.5f;
+
+			for (int x = std::max(minX, tileX); x < maxX; x++) {
+				float pixelX = x + 0.5f;
+
+				float weights[3];
+				bool inside = true;
+				for (int e = 0; e < 3; e++) {
+					float value = triangle.edgeA[e] * pixelX + triangle.edgeB[e] * pixelY + triangle.edgeC[e];
+					inside = inside && (value > 0 || (value == 0 && triangle.topLeft[e]));
+					weights[e] = value * triangle.inverseArea;
+				}
+
+				if (!inside)
+					continue;
+
+				float color[4];
+				for (int channel = 0; channel < 4; channel++)
+					color[channel] = weights[0] * triangle.color[0][channel] + weights[1] * triangle.color[1][channel] + weights[2] * triangle.color[2][channel];
+
+				row[x] = PackColor(color);
+				pixels++;
+			}
+		}
+#endif
+	}
+
+	tilePixels[tile] = pixels;
+}
+
+/*
+* Binning is serial (it is cheap), tiles are independent and go to the job system
+*/
+void SoftwareRasterizer::EndFrame() {
+	auto startTime = std::chrono::steady_clock::now();
+
+	for (std::vector<uint32_t>& bin : bins)
+		bin.clear();
+
+	for (size_t i = 0; i < triangles.size(); i++) {
+		const Triangle& triangle = triangles[i];
+
+		int firstTileX = triangle.minX / TILE_SIZE;
+		int firstTileY = triangle.minY / TILE_SIZE;
+		int lastTileX = (triangle.maxX - 1) / TILE_SIZE;
+		int lastTileY = (triangle.maxY - 1) / TILE_SIZE;
+
+		for (int tileY = firstTileY; tileY <= lastTileY; tileY++)
+			for (int tileX = firstTileX; tileX <= lastTileX; tileX++)
+				bins[tileY * tilesX + tileX].push_back(static_cast<uint32_t>(i));
+	}
+
+	auto rasterize = [this](size_t begin, size_t end) {
+		for (size_t tile = begin; tile < end; tile++)
+			RasterizeTile(static_cast<int>(tile));
+	};
+
+	if (jobSystem)
+		jobSystem->ParallelFor(bins.size(), 1, rasterize);
+	else
+		rasterize(0, bins.size());
+
+	statistics.triangles = static_cast<unsigned int>(triangles.size());
+	statistics.pixels = 0;
+	for (unsigned long long pixels : tilePixels)
+		statistics.pixels += pixels;
+
+	statistics.seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+	statistics.megapixelsPerSecond = statistics.seconds > 0 ? statistics.pixels / statistics.seconds / 1000000.0f : 0;
+	statistics.trianglesPerSecond = statistics.seconds > 0 ? statistics.triangles / statistics.seconds : 0;
+}
+
+/*
+* Binary PPM (P6), alpha is dropped
+*/
+bool SoftwareRasterizer::WritePPM(const std::string& path) const {
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+
+	file << "P6\n" << width << " " << height << "\n255\n";
+
+	std::vector<unsigned char> rgb(static_cast<size_t>(width) * height * 3);
+	for (size_t i = 0; i < framebuffer.size(); i++) {
+		rgb[i * 3 + 0] = static_cast<unsigned char>(framebuffer[i]);
+		rgb[i * 3 + 1] = static_cast<unsigned char>(framebuffer[i] >> 8);
+		rgb[i * 3 + 2] = static_cast<unsigned char>(framebuffer[i] >> 16);
+	}
+	file.write(reinterpret_cast<const char*>(rgb.data()), rgb.size());
+
+	return static_cast<bool>(file);
+}
+
+int SoftwareRasterizer::GetWidth() const {
+	return width;
+}
+
+int SoftwareRasterizer::GetHeight() const {
+	return height;
+}
+
+const std::vector<uint32_t>& SoftwareRasterizer::GetFramebuffer() const {
+	return framebuffer;
+}
+
+const SoftwareRasterizer::Statistics& SoftwareRasterizer::GetStatistics() const {
+	return statistics;
+}
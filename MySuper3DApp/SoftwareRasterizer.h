@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+/*
+* Vertex of the software pipeline, the same layout as "RenderComponent::points" (two float4)
+*/
+struct SoftwareVertex {
+	float position[4];
+	float color[4];
+};
+
+/*
+* CPU implementation of the "MyVeryFirstShader.hlsl" pipeline
+* Vertex stage: position times world matrix, color passed through
+* Pixel stage: interpolated vertex color into an RGBA8 framebuffer, no depth test (draw order wins)
+* Triangles are binned into screen tiles, tiles are rasterized in parallel with SIMD edge functions
+*/
+class SoftwareRasterizer {
+public:
+	static const int TILE_SIZE = 64; // Pixels, multiple of 4
+
+	struct Statistics {
+		unsigned int triangles; // Triangles set up (after culling of degenerate and off-screen ones)
+		unsigned long long pixels; // Pixels written
+		float seconds; // Binning and rasterization time of the frame
+		float megapixelsPerSecond;
+		float trianglesPerSecond;
+	};
+
+private:
+	// Screen space triangle with edge functions "a * x + b * y + c" (positive inside)
+	struct Triangle {
+		float edgeA[3];
+		float edgeB[3];
+		float edgeC[3];
+		bool topLeft[3]; // Pixels exactly on a top or left edge belong to the triangle
+		float color[3][4];
+		float inverseArea;
+		int minX, minY, maxX, maxY; // Bounding box clamped to the screen (max is exclusive)
+	};
+
+	int width;
+	int height;
+	int tilesX;
+	int tilesY;
+	JobSystem* jobSystem; // nullptr - single thread
+
+	std::vector<uint32_t> framebuffer; // RGBA8, "R" in the lowest byte
+	std::vector<Triangle> triangles; // Of the current frame in submission order
+	std::vector<std::vector<uint32_t>> bins; // Triangle indices per tile
+	std::vector<unsigned long long> tilePixels; // Written pixels per tile
+	uint32_t clearColor;
+	Statistics statistics;
+
+	void SetupTriangle(const float* p0, const float* p1, const float* p2, const float* c0, const float* c1, const float* c2);
+	void RasterizeTile(int tile);
+
+public:
+	SoftwareRasterizer(int width, int height, JobSystem* jobSystem);
+
+	void BeginFrame(const float clearColor[4]);
+	// Indexed triangle list, "world" is a row-major 4x4 matrix for row vectors (nullptr - identity)
+	void DrawIndexed(const SoftwareVertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount, int baseVertex, const float* world);
+	void DrawIndexed16(const SoftwareVertex* vertices, size_t vertexCount, const uint16_t* indices, size_t indexCount, int baseVertex, const float* world);
+	void EndFrame(); // Bin and rasterize all triangles of the frame
+
+	bool WritePPM(const std::string& path) const;
+
+	int GetWidth() const;
+	int GetHeight() const;
+	const std::vector<uint32_t>& GetFramebuffer() const;
+	const Statistics& GetStatistics() const;
+};
@@ -0,0 +1,147 @@
+#include "SpriteBatcher.h"
+#include "RenderCommandBuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+SpriteBatcher::SpriteBatcher() {
+	quadCount = 0;
+	lastBucket = 0;
+
+	// The same triangles as "SquareRenderComponent": 0, 1, 2, 1, 0, 3
+	quadIndices.reserve(MAX_QUADS_PER_BATCH * 6);
+	for (uint32_t i = 0; i < MAX_QUADS_PER_BATCH; i++) {
+		uint16_t base = static_cast<uint16_t>(i * 4);
+		quadIndices.insert(quadIndices.end(), {
+			base, static_cast<uint16_t>(base + 1), static_cast<uint16_t>(base + 2),
+			static_cast<uint16_t>(base + 1), base, static_cast<uint16_t>(base + 3)
+		});
+	}
+}
+
+/*
+* Start a frame, buckets keep their memory
+*/
+void SpriteBatcher::Begin() {
+	for (Bucket& bucket : buckets) {
+		bucket.vertices.clear();
+		bucket.depths.clear();
+	}
+
+	vertices.clear();
+	batches.clear();
+	quadCount = 0;
+}
+
+void SpriteBatcher::AddQuad(uint32_t state, const SpriteVertex quad[4], const float* world, float depth) {
+	// Runs of the same state skip the hash lookup
+	if (buckets.empty() || buckets[lastBucket].state != state) {
+		auto found = bucketIndices.find(state);
+		if (found != bucketIndices.end())
+			lastBucket = found->second;
+		else {
+			lastBucket = buckets.size();
+			buckets.push_back({ state, {}, {} });
+			bucketIndices[state] = lastBucket;
+		}
+	}
+
+	buckets[lastBucket].depths.push_back(depth);
+
+	std::vector<SpriteVertex>& bucketVertices = buckets[lastBucket].vertices;
+	size_t first = bucketVertices.size();
+	bucketVertices.resize(first + 4);
+	SpriteVertex* target = bucketVertices.data() + first;
+	quadCount++;
+
+	if (!world) {
+		memcpy(target, quad, 4 * sizeof(SpriteVertex));
+		return;
+	}
+
+	// Row vector times matrix, as in the vertex shader
+	for (int i = 0; i < 4; i++) {
+		const float* position = quad[i].position;
+
+		for (int column = 0; column < 4; column++)
+			target[i].position[column] = position[0] * world[column] + position[1] * world[4 + column] + position[2] * world[8 + column] + position[3] * world[12 + column];
+
+		memcpy(target[i].color, quad[i].color, sizeof(quad[i].color));
+	}
+}
+
+/*
+* Concatenate buckets into one stream
+* Quads of a bucket go back to front (larger depth first), equal depths keep the order of AddQuad(),
+* a bucket already in that order is copied at once
+* A bucket bigger than MAX_QUADS_PER_BATCH is split, the shared indices can't address more
+*/
+void SpriteBatcher::End() {
+	vertices.resize(quadCount * 4);
+
+	size_t offset = 0;
+	for (const Bucket& bucket : buckets) {
+		if (bucket.vertices.empty())
+			continue;
+
+		size_t quads = bucket.vertices.size() / 4;
+		const std::vector<float>& depths = bucket.depths;
+
+		if (std::is_sorted(depths.begin(), depths.end(), std::greater<float>()))
+			memcpy(vertices.data() + offset, bucket.vertices.data(), bucket.vertices.size() * sizeof(SpriteVertex));
+		else {
+			sortOrder.resize(quads);
+			for (size_t i = 0; i < quads; i++)
+				sortOrder[i] = static_cast<uint32_t>(i);
+
+			std::stable_sort(sortOrder.begin(), sortOrder.end(), [&depths](uint32_t a, uint32_t b) {
+				return depths[a] > depths[b];
+			});
+
+			for (size_t i = 0; i < quads; i++)
+				memcpy(vertices.data() + offset + i * 4, bucket.vertices.data() + sortOrder[i] * 4, 4 * sizeof(SpriteVertex));
+		}
+
+		for (size_t first = 0; first < quads; first += MAX_QUADS_PER_BATCH) {
+			uint32_t count = static_cast<uint32_t>(std::min<size_t>(MAX_QUADS_PER_BATCH, quads - first));
+			batches.push_back({ bucket.state, static_cast<uint32_t>(offset + first * 4), count });
+		}
+
+		offset += bucket.vertices.size();
+	}
+}
+
+/*
+* Quads are already transformed, so the constants are an identity world matrix
+* The stream is transient, valid until the next Begin()
+*/
+void SpriteBatcher::FillPacket(const Batch& batch, DrawPacket& packet) const {
+	packet.vertexBuffer = vertices.data();
+	packet.indexBuffer = quadIndices.data();
+	packet.vertexStride = sizeof(SpriteVertex);
+	packet.vertexCount = static_cast<uint32_t>(vertices.size());
+	packet.indexCount = batch.quadCount * 6;
+	packet.startIndex = 0;
+	packet.baseVertex = static_cast<int32_t>(batch.firstVertex);
+	packet.indexFormat = INDEX_FORMAT_R16_UINT;
+	packet.flags |= DrawPacket::TRANSIENT_VERTICES;
+
+	memset(packet.constants, 0, sizeof(packet.constants));
+	packet.constants[0] = packet.constants[5] = packet.constants[10] = packet.constants[15] = 1.0f;
+}
+
+const std::vector<SpriteVertex>& SpriteBatcher::GetVertices() const {
+	return vertices;
+}
+
+const std::vector<SpriteBatcher::Batch>& SpriteBatcher::GetBatches() const {
+	return batches;
+}
+
+const std::vector<uint16_t>& SpriteBatcher::GetQuadIndices() const {
+	return quadIndices;
+}
+
+size_t SpriteBatcher::GetQuadCount() const {
+	return quadCount;
+}
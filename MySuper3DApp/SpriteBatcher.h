@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct DrawPacket;
+
+/*
+* Vertex of a sprite quad, the same layout as "RenderComponent::points" (two float4)
+*/
+struct SpriteVertex {
+	float position[4];
+	float color[4];
+};
+
+/*
+* CPU side of 2D batching
+* Quads are transformed to world space on add and grouped by render state,
+* End() lays all buckets out in one vertex stream with one batch (draw call) per state
+* Inside a bucket quads are sorted back to front by depth, quads of different states are not interleaved
+*/
+class SpriteBatcher {
+public:
+	static const uint32_t MAX_QUADS_PER_BATCH = 16384; // 16-bit indices
+
+	struct Batch {
+		uint32_t state; // Render state key of all quads in the batch
+		uint32_t firstVertex; // Base vertex in the stream
+		uint32_t quadCount;
+	};
+
+private:
+	struct Bucket {
+		uint32_t state;
+		std::vector<SpriteVertex> vertices;
+		std::vector<float> depths; // Of every quad
+	};
+
+	std::vector<Bucket> buckets; // In order of the first use of a state, kept between frames
+	std::unordered_map<uint32_t, size_t> bucketIndices; // State -> bucket
+	std::vector<SpriteVertex> vertices; // Stream made by End()
+	std::vector<Batch> batches;
+	std::vector<uint16_t> quadIndices; // Shared index pattern for MAX_QUADS_PER_BATCH quads
+	std::vector<uint32_t> sortOrder; // Quads of a bucket back to front
+	size_t quadCount;
+	size_t lastBucket; // Bucket of the previous quad
+
+public:
+	SpriteBatcher();
+
+	void Begin();
+	void AddQuad(uint32_t state, const SpriteVertex quad[4], const float* world, float depth = 0); // "world" is a row-major 4x4 matrix for row vectors (nullptr - identity)
+	void End();
+
+	void FillPacket(const Batch& batch, DrawPacket& packet) const; // Geometry of a batch, vertices stay in the stream of End()
+
+	const std::vector<SpriteVertex>& GetVertices() const;
+	const std::vector<Batch>& GetBatches() const;
+	const std::vector<uint16_t>& GetQuadIndices() const;
+	size_t GetQuadCount() const;
+};
@@ -0,0 +1,76 @@
+#include "SpriteRenderer.h"
+#include "ShaderLibrary.h"
+#include "D3D11StateCache.h"
+#include "RenderCommandBuffer.h"
+#include "SimpleMath.h"
+#include <iostream>
+
+/*
+* Shaders are the same as "RenderComponent" uses, the world matrix is identity
+* Input layout and rasterizer state come from the state cache, so they are the objects of the meshes
+*/
+bool SpriteRenderer::Initialize(Microsoft::WRL::ComPtr<ID3D11Device> device, std::shared_ptr<ShaderLibrary> shaderLibrary, std::shared_ptr<D3D11StateCache> stateCache, const SpriteBatcher& batcher) {
+	ShaderDesc vertexShaderDesc = { "./Shaders/MyVeryFirstShader.hlsl", "VSMain", "vs_5_0", {}, ShaderLibrary::GetDefaultFlags() };
+	ShaderDesc pixelShaderDesc = { "./Shaders/MyVeryFirstShader.hlsl", "PSMain", "ps_5_0", {}, ShaderLibrary::GetDefaultFlags() };
+
+	std::string errors;
+	std::shared_ptr<const ShaderBytecode> vertexShaderByteCode;
+	vertexShader = shaderLibrary->GetVertexShader(vertexShaderDesc, errors, &vertexShaderByteCode);
+	pixelShader = shaderLibrary->GetPixelShader(pixelShaderDesc, errors);
+	if (!vertexShader || !pixelShader) {
+		std::cout << errors << std::endl;
+		return false;
+	}
+
+	// Explicit offsets, as "VertexLayout::Full()" generates them for meshes, so the descriptors are equal
+	D3D11_INPUT_ELEMENT_DESC inputElements[] = {
+		{ "POSITION", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 16, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	};
+
+	layout = stateCache->GetInputLayout(inputElements, 2, vertexShaderByteCode->data(), vertexShaderByteCode->size());
+
+	const std::vector<uint16_t>& quadIndices = batcher.GetQuadIndices();
+
+	D3D11_BUFFER_DESC indexBufDesc = {};
+	indexBufDesc.ByteWidth = static_cast<UINT>(sizeof(uint16_t) * quadIndices.size());
+	indexBufDesc.Usage = D3D11_USAGE_IMMUTABLE;
+	indexBufDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+
+	D3D11_SUBRESOURCE_DATA indexData = {};
+	indexData.pSysMem = quadIndices.data();
+
+	device->CreateBuffer(&indexBufDesc, &indexData, indexBuf.GetAddressOf());
+
+	// Not immutable: without the constant ring the executor updates it with the identity of the packet
+	D3D11_BUFFER_DESC constBufDesc = {};
+	constBufDesc.ByteWidth = sizeof(DirectX::SimpleMath::Matrix);
+	constBufDesc.Usage = D3D11_USAGE_DEFAULT;
+	constBufDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+
+	D3D11_SUBRESOURCE_DATA constData = {};
+	constData.pSysMem = &DirectX::SimpleMath::Matrix::Identity;
+
+	device->CreateBuffer(&constBufDesc, &constData, constBuf.GetAddressOf());
+
+	CD3D11_RASTERIZER_DESC rastDesc(D3D11_DEFAULT);
+	rastDesc.CullMode = D3D11_CULL_NONE;
+	rastDesc.FillMode = D3D11_FILL_SOLID;
+	rastDesc.DepthClipEnable = FALSE; // Same state as render components
+
+	rastState = stateCache->GetRasterizerState(rastDesc);
+
+	return true;
+}
+
+/*
+* All batches share pipeline state now, a state per batch would be chosen by "Batch::state" here
+*/
+void SpriteRenderer::FillPacket(DrawPacket& packet) const {
+	packet.vertexShader = vertexShader.Get();
+	packet.pixelShader = pixelShader.Get();
+	packet.inputLayout = layout.Get();
+	packet.rasterizerState = rastState.Get();
+	packet.indexBuffer = indexBuf.Get();
+	packet.constantBuffer = constBuf.Get();
+}
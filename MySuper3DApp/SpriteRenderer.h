@@ -0,0 +1,26 @@
+#pragma once
+#include <wrl.h>
+#include <d3d11.h>
+#include <memory>
+#include "SpriteBatcher.h"
+
+class ShaderLibrary;
+class D3D11StateCache;
+struct DrawPacket;
+
+/*
+* GPU side of "SpriteBatcher": pipeline state of sprite batch packets
+* One static index buffer with the shared quad pattern, the vertex stream is uploaded by the command executor
+*/
+class SpriteRenderer {
+	Microsoft::WRL::ComPtr<ID3D11VertexShader> vertexShader;
+	Microsoft::WRL::ComPtr<ID3D11PixelShader> pixelShader;
+	Microsoft::WRL::ComPtr<ID3D11InputLayout> layout;
+	Microsoft::WRL::ComPtr<ID3D11RasterizerState> rastState;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuf;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> constBuf; // Identity world matrix, vertices are already in view space
+
+public:
+	bool Initialize(Microsoft::WRL::ComPtr<ID3D11Device> device, std::shared_ptr<ShaderLibrary> shaderLibrary, std::shared_ptr<D3D11StateCache> stateCache, const SpriteBatcher& batcher);
+	void FillPacket(DrawPacket& packet) const; // After SpriteBatcher::FillPacket()
+};
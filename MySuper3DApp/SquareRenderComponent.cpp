@@ -4,7 +4,35 @@ SquareRenderComponent::SquareRenderComponent() : RenderComponent() {
 	indeces.insert(indeces.end(), { 0, 1, 2, 1, 0, 3 });
 }
 
-SquareRenderComponent::SquareRenderComponent(std::shared_ptr<DirectX::SimpleMath::Vector4> renderOffset) :
-	RenderComponent(renderOffset) {
+SquareRenderComponent::SquareRenderComponent(TransformSystem* transforms, TransformId transform) :
+	RenderComponent(transforms, transform) {
 	indeces.insert(indeces.end(), { 0, 1, 2, 1, 0, 3 });
 }
+
+/*
+* A batched square is only a quad in the shared sprite stream, it has no buffers of its own
+*/
+void SquareRenderComponent::Initialize() {
+	if (Game::instance->IsSpriteBatching() && points.size() == 8) {
+		ComputeBounds();
+		return;
+	}
+
+	RenderComponent::Initialize();
+}
+
+/*
+* With sprite batching the quad is only added to the batch of the frame
+* "points" must hold 4 vertices (position and color)
+*/
+void SquareRenderComponent::Draw() {
+	SpriteBatcher* batcher = Game::instance->GetSpriteBatcher();
+	if (!batcher || points.size() != 8) {
+		RenderComponent::Draw();
+		return;
+	}
+
+	DirectX::SimpleMath::Matrix worldView = GetWorldMatrix() * Game::instance->GetViewMatrix();
+	float depth = DirectX::SimpleMath::Vector3::Transform(localBounds.Center, worldView).z;
+	batcher->AddQuad(0, reinterpret_cast<const SpriteVertex*>(points.data()), &worldView._11, depth);
+}
@@ -4,5 +4,8 @@
 class SquareRenderComponent : public RenderComponent {
 public:
 	SquareRenderComponent();
-	SquareRenderComponent(std::shared_ptr<DirectX::SimpleMath::Vector4> renderOffset);
+	SquareRenderComponent(TransformSystem* transforms, TransformId transform);
+
+	void Initialize();
+	void Draw();
 };
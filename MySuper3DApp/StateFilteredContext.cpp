@@ -0,0 +1,163 @@
+#include "StateFilteredContext.h"
+
+StateFilteredContext::StateFilteredContext(Microsoft::WRL::ComPtr<ID3D11DeviceContext> context) {
+	this->context = context;
+	context.As(&context1);
+
+	statistics = {};
+	Invalidate();
+}
+
+void StateFilteredContext::Invalidate() {
+	known = 0;
+	inputLayout = nullptr;
+	topology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	indexBuffer = nullptr;
+	indexFormat = DXGI_FORMAT_UNKNOWN;
+	indexOffset = 0;
+	vertexBuffer = nullptr;
+	vertexStride = 0;
+	vertexOffset = 0;
+	vertexShader = nullptr;
+	pixelShader = nullptr;
+	rasterizerState = nullptr;
+	constantBuffer = nullptr;
+	firstConstant = 0;
+	constantCount = 0;
+}
+
+/*
+* A call is skipped only if the shadow value is known and equal
+*/
+bool StateFilteredContext::Filter(unsigned int bit, bool same) {
+	if ((known & bit) && same) {
+		statistics.skipped++;
+		return false;
+	}
+
+	known |= bit;
+	statistics.issued++;
+	return true;
+}
+
+void StateFilteredContext::IASetInputLayout(ID3D11InputLayout* layout) {
+	if (!Filter(INPUT_LAYOUT, layout == inputLayout))
+		return;
+
+	inputLayout = layout;
+	context->IASetInputLayout(layout);
+}
+
+void StateFilteredContext::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) {
+	if (!Filter(TOPOLOGY, topology == this->topology))
+		return;
+
+	this->topology = topology;
+	context->IASetPrimitiveTopology(topology);
+}
+
+void StateFilteredContext::IASetIndexBuffer(ID3D11Buffer* buffer, DXGI_FORMAT format, UINT offset) {
+	if (!Filter(INDEX_BUFFER, buffer == indexBuffer && format == indexFormat && offset == indexOffset))
+		return;
+
+	indexBuffer = buffer;
+	indexFormat = format;
+	indexOffset = offset;
+	context->IASetIndexBuffer(buffer, format, offset);
+}
+
+/*
+* Only slot 0 is tracked
+*/
+void StateFilteredContext::IASetVertexBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* buffers, const UINT* strides, const UINT* offsets) {
+	if (startSlot != 0 || bufferCount != 1) {
+		if (startSlot == 0)
+			known &= ~VERTEX_BUFFER;
+		statistics.issued++;
+		context->IASetVertexBuffers(startSlot, bufferCount, buffers, strides, offsets);
+		return;
+	}
+
+	if (!Filter(VERTEX_BUFFER, buffers[0] == vertexBuffer && strides[0] == vertexStride && offsets[0] == vertexOffset))
+		return;
+
+	vertexBuffer = buffers[0];
+	vertexStride = strides[0];
+	vertexOffset = offsets[0];
+	context->IASetVertexBuffers(startSlot, bufferCount, buffers, strides, offsets);
+}
+
+void StateFilteredContext::VSSetShader(ID3D11VertexShader* shader) {
+	if (!Filter(VERTEX_SHADER, shader == vertexShader))
+		return;
+
+	vertexShader = shader;
+	context->VSSetShader(shader, nullptr, 0);
+}
+
+void StateFilteredContext::PSSetShader(ID3D11PixelShader* shader) {
+	if (!Filter(PIXEL_SHADER, shader == pixelShader))
+		return;
+
+	pixelShader = shader;
+	context->PSSetShader(shader, nullptr, 0);
+}
+
+void StateFilteredContext::RSSetState(ID3D11RasterizerState* state) {
+	if (!Filter(RASTERIZER_STATE, state == rasterizerState))
+		return;
+
+	rasterizerState = state;
+	context->RSSetState(state);
+}
+
+/*
+* Only slot 0 is tracked, a whole buffer binding is stored as range 0, 0
+*/
+void StateFilteredContext::VSSetConstantBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* buffers) {
+	if (startSlot != 0 || bufferCount != 1) {
+		if (startSlot == 0)
+			known &= ~VS_CONSTANT_BUFFER;
+		statistics.issued++;
+		context->VSSetConstantBuffers(startSlot, bufferCount, buffers);
+		return;
+	}
+
+	if (!Filter(VS_CONSTANT_BUFFER, buffers[0] == constantBuffer && firstConstant == 0 && constantCount == 0))
+		return;
+
+	constantBuffer = buffers[0];
+	firstConstant = 0;
+	constantCount = 0;
+	context->VSSetConstantBuffers(startSlot, bufferCount, buffers);
+}
+
+void StateFilteredContext::VSSetConstantBuffers1(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* buffers, const UINT* firstConstants, const UINT* constantCounts) {
+	if (startSlot != 0 || bufferCount != 1) {
+		if (startSlot == 0)
+			known &= ~VS_CONSTANT_BUFFER;
+		statistics.issued++;
+		context1->VSSetConstantBuffers1(startSlot, bufferCount, buffers, firstConstants, constantCounts);
+		return;
+	}
+
+	if (!Filter(VS_CONSTANT_BUFFER, buffers[0] == constantBuffer && firstConstants[0] == firstConstant && constantCounts[0] == constantCount))
+		return;
+
+	constantBuffer = buffers[0];
+	firstConstant = firstConstants[0];
+	constantCount = constantCounts[0];
+	context1->VSSetConstantBuffers1(startSlot, bufferCount, buffers, firstConstants, constantCounts);
+}
+
+void StateFilteredContext::DrawIndexed(UINT indexCount, UINT startIndex, INT baseVertex) {
+	context->DrawIndexed(indexCount, startIndex, baseVertex);
+}
+
+Microsoft::WRL::ComPtr<ID3D11DeviceContext> StateFilteredContext::GetContext() {
+	return context;
+}
+
+const StateFilteredContext::Statistics& StateFilteredContext::GetStatistics() const {
+	return statistics;
+}
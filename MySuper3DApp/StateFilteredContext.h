@@ -0,0 +1,73 @@
+#pragma once
+#include <wrl.h>
+#include <d3d11_1.h>
+
+/*
+* Immediate context wrapper that skips binds of objects that are already bound
+* Keeps a shadow copy of the pipeline state the engine uses (one vertex buffer,
+* one vertex shader constant buffer), other slots go straight to the context
+* Shadow state holds raw pointers: call Invalidate() after ClearState()
+* and after anything binds through the context directly
+*/
+class StateFilteredContext {
+public:
+	struct Statistics {
+		unsigned long long issued; // Calls passed to the context
+		unsigned long long skipped; // Calls equal to the bound state
+	};
+
+private:
+	enum StateBit {
+		INPUT_LAYOUT = 1 << 0,
+		TOPOLOGY = 1 << 1,
+		INDEX_BUFFER = 1 << 2,
+		VERTEX_BUFFER = 1 << 3,
+		VERTEX_SHADER = 1 << 4,
+		PIXEL_SHADER = 1 << 5,
+		RASTERIZER_STATE = 1 << 6,
+		VS_CONSTANT_BUFFER = 1 << 7
+	};
+
+	Microsoft::WRL::ComPtr<ID3D11DeviceContext> context;
+	Microsoft::WRL::ComPtr<ID3D11DeviceContext1> context1; // For constant buffer offsets (may be nullptr)
+
+	unsigned int known; // StateBit of every shadow value that matches the context
+	ID3D11InputLayout* inputLayout;
+	D3D11_PRIMITIVE_TOPOLOGY topology;
+	ID3D11Buffer* indexBuffer;
+	DXGI_FORMAT indexFormat;
+	UINT indexOffset;
+	ID3D11Buffer* vertexBuffer;
+	UINT vertexStride;
+	UINT vertexOffset;
+	ID3D11VertexShader* vertexShader;
+	ID3D11PixelShader* pixelShader;
+	ID3D11RasterizerState* rasterizerState;
+	ID3D11Buffer* constantBuffer;
+	UINT firstConstant; // 0 and 0 for the whole buffer
+	UINT constantCount;
+
+	Statistics statistics;
+
+	bool Filter(unsigned int bit, bool same); // true if the call must be issued
+
+public:
+	StateFilteredContext(Microsoft::WRL::ComPtr<ID3D11DeviceContext> context);
+
+	void Invalidate(); // Nothing is known about the bound state
+
+	void IASetInputLayout(ID3D11InputLayout* layout);
+	void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology);
+	void IASetIndexBuffer(ID3D11Buffer* buffer, DXGI_FORMAT format, UINT offset);
+	void IASetVertexBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* buffers, const UINT* strides, const UINT* offsets);
+	void VSSetShader(ID3D11VertexShader* shader);
+	void PSSetShader(ID3D11PixelShader* shader);
+	void RSSetState(ID3D11RasterizerState* state);
+	void VSSetConstantBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* buffers);
+	void VSSetConstantBuffers1(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* buffers, const UINT* firstConstants, const UINT* constantCounts);
+
+	void DrawIndexed(UINT indexCount, UINT startIndex, INT baseVertex);
+
+	Microsoft::WRL::ComPtr<ID3D11DeviceContext> GetContext(); // For everything that is not filtered
+	const Statistics& GetStatistics() const;
+};
@@ -0,0 +1,24 @@
+#include "StubShaderCompiler.h"
+
+StubShaderCompiler::StubShaderCompiler() {
+	compileCount = 0;
+}
+
+bool StubShaderCompiler::Compile(const std::string& source, const ShaderDesc& desc, ShaderBytecode& bytecode, std::string& errors) {
+	compileCount++;
+
+	if (desc.entryPoint.empty() || source.find(desc.entryPoint) == std::string::npos) {
+		errors = desc.path + ": entry point \"" + desc.entryPoint + "\" not found";
+		return false;
+	}
+
+	bytecode.assign(desc.profile.begin(), desc.profile.end());
+	bytecode.push_back(0);
+	bytecode.insert(bytecode.end(), source.begin(), source.end());
+
+	return true;
+}
+
+unsigned int StubShaderCompiler::GetCompileCount() const {
+	return compileCount;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include "ShaderCache.h"
+
+/*
+* "IShaderCompiler" without a GPU compiler, for platforms without "Direct3D" and for tests
+* Only checks that the entry point is in the source, the "bytecode" is the profile and the source text
+*/
+class StubShaderCompiler : public IShaderCompiler {
+	unsigned int compileCount;
+
+public:
+	StubShaderCompiler();
+
+	bool Compile(const std::string& source, const ShaderDesc& desc, ShaderBytecode& bytecode, std::string& errors) override;
+
+	unsigned int GetCompileCount() const; // Calls of Compile(), failed ones too
+};
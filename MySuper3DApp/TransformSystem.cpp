@@ -0,0 +1,300 @@
+#include "TransformSystem.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace DirectX::SimpleMath;
+
+const uint32_t TransformId::INVALID_SLOT;
+
+TransformSystem::TransformSystem() {
+	anyDirty = false;
+	recomputedCount = 0;
+}
+
+/*
+* Setters and getters take only live handles, a stale one would address another transform
+*/
+uint32_t TransformSystem::GetIndex(TransformId transform) const {
+	assert(IsAlive(transform) && "Transform is invalid or destroyed");
+	return slots[transform.slot].index;
+}
+
+/*
+* std::rotate on all pools: [middle; last) is moved in front of [first; middle)
+* Slots of moved elements are fixed after that
+*/
+void TransformSystem::Rotate(size_t first, size_t middle, size_t last) {
+	if (first == middle || middle == last)
+		return;
+
+	std::rotate(positions.begin() + first, positions.begin() + middle, positions.begin() + last);
+	std::rotate(rotations.begin() + first, rotations.begin() + middle, rotations.begin() + last);
+	std::rotate(scales.begin() + first, scales.begin() + middle, scales.begin() + last);
+	std::rotate(worldMatrices.begin() + first, worldMatrices.begin() + middle, worldMatrices.begin() + last);
+	std::rotate(parents.begin() + first, parents.begin() + middle, parents.begin() + last);
+	std::rotate(subtreeSizes.begin() + first, subtreeSizes.begin() + middle, subtreeSizes.begin() + last);
+	std::rotate(dirty.begin() + first, dirty.begin() + middle, dirty.begin() + last);
+	std::rotate(changed.begin() + first, changed.begin() + middle, changed.begin() + last);
+	std::rotate(owners.begin() + first, owners.begin() + middle, owners.begin() + last);
+
+	for (size_t i = first; i < last; i++)
+		slots[owners[i]].index = static_cast<uint32_t>(i);
+}
+
+void TransformSystem::AddToAncestors(uint32_t parentSlot, int count) {
+	while (parentSlot != TransformId::INVALID_SLOT) {
+		uint32_t index = slots[parentSlot].index;
+		subtreeSizes[index] += count;
+		parentSlot = parents[index];
+	}
+}
+
+/*
+* New transform is placed right after the last descendant of the parent
+*/
+TransformId TransformSystem::Create(TransformId parent) {
+	uint32_t slot;
+	if (!freeSlots.empty()) {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else {
+		slot = static_cast<uint32_t>(slots.size());
+		slots.push_back({ 0, 0 });
+	}
+
+	size_t index = positions.size();
+	slots[slot].index = static_cast<uint32_t>(index);
+
+	positions.push_back(Vector3::Zero);
+	rotations.push_back(Quaternion::Identity);
+	scales.push_back(Vector3::One);
+	worldMatrices.push_back(Matrix::Identity);
+	parents.push_back(TransformId::INVALID_SLOT);
+	subtreeSizes.push_back(1);
+	dirty.push_back(1);
+	changed.push_back(0);
+	owners.push_back(slot);
+	anyDirty = true;
+
+	TransformId transform(slot, slots[slot].generation);
+	if (IsAlive(parent))
+		SetParent(transform, parent);
+
+	return transform;
+}
+
+void TransformSystem::Destroy(TransformId transform) {
+	if (!IsAlive(transform))
+		return;
+
+	size_t index = GetIndex(transform);
+	size_t count = subtreeSizes[index];
+
+	AddToAncestors(parents[index], -static_cast<int>(count));
+	Rotate(index, index + count, positions.size());
+
+	for (size_t i = 0; i < count; i++) {
+		uint32_t slot = owners.back();
+		slots[slot].generation++;
+		freeSlots.push_back(slot);
+
+		positions.pop_back();
+		rotations.pop_back();
+		scales.pop_back();
+		worldMatrices.pop_back();
+		parents.pop_back();
+		subtreeSizes.pop_back();
+		dirty.pop_back();
+		changed.pop_back();
+		owners.pop_back();
+	}
+}
+
+bool TransformSystem::IsAlive(TransformId transform) const {
+	return transform.slot < slots.size()
+		&& slots[transform.slot].generation == transform.generation
+		&& slots[transform.slot].index < positions.size()
+		&& owners[slots[transform.slot].index] == transform.slot;
+}
+
+/*
+* Move the whole subtree behind the last descendant of the new parent
+* Parent can't be a descendant of the transform
+*/
+void TransformSystem::SetParent(TransformId transform, TransformId parent) {
+	if (!IsAlive(transform))
+		return;
+
+	size_t index = GetIndex(transform);
+	size_t count = subtreeSizes[index];
+
+	if (IsAlive(parent)) {
+		size_t parentIndex = GetIndex(parent);
+		if (parentIndex >= index && parentIndex < index + count)
+			return;
+	}
+
+	AddToAncestors(parents[index], -static_cast<int>(count));
+
+	// Move subtree to the end first, so the rest is a valid tree without it
+	size_t end = positions.size();
+	Rotate(index, index + count, end);
+
+	size_t target = end - count;
+	if (IsAlive(parent)) {
+		size_t parentIndex = GetIndex(parent);
+		target = parentIndex + subtreeSizes[parentIndex];
+	}
+
+	Rotate(target, end - count, end);
+
+	index = GetIndex(transform);
+	parents[index] = IsAlive(parent) ? parent.slot : TransformId::INVALID_SLOT;
+	AddToAncestors(parents[index], static_cast<int>(count));
+
+	dirty[index] = 1;
+	anyDirty = true;
+}
+
+TransformId TransformSystem::GetParent(TransformId transform) const {
+	if (!IsAlive(transform))
+		return TransformId();
+
+	uint32_t parentSlot = parents[GetIndex(transform)];
+	if (parentSlot == TransformId::INVALID_SLOT)
+		return TransformId();
+
+	return TransformId(parentSlot, slots[parentSlot].generation);
+}
+
+void TransformSystem::SetPosition(TransformId transform, const Vector3& position) {
+	uint32_t index = GetIndex(transform);
+	positions[index] = position;
+	dirty[index] = 1;
+	anyDirty = true;
+}
+
+void TransformSystem::SetRotation(TransformId transform, const Quaternion& rotation) {
+	uint32_t index = GetIndex(transform);
+	rotations[index] = rotation;
+	dirty[index] = 1;
+	anyDirty = true;
+}
+
+void TransformSystem::SetScale(TransformId transform, const Vector3& scale) {
+	uint32_t index = GetIndex(transform);
+	scales[index] = scale;
+	dirty[index] = 1;
+	anyDirty = true;
+}
+
+void TransformSystem::Translate(TransformId transform, const Vector3& offset) {
+	uint32_t index = GetIndex(transform);
+	positions[index] += offset;
+	dirty[index] = 1;
+	anyDirty = true;
+}
+
+Vector3 TransformSystem::GetPosition(TransformId transform) const {
+	return positions[GetIndex(transform)];
+}
+
+Quaternion TransformSystem::GetRotation(TransformId transform) const {
+	return rotations[GetIndex(transform)];
+}
+
+Vector3 TransformSystem::GetScale(TransformId transform) const {
+	return scales[GetIndex(transform)];
+}
+
+const Matrix& TransformSystem::GetWorldMatrix(TransformId transform) const {
+	return worldMatrices[GetIndex(transform)];
+}
+
+/*
+* One pass in depth-first order
+* A matrix is recomputed if its transform is dirty or the parent matrix changed in this pass
+*/
+void TransformSystem::UpdateWorldMatrices() {
+	recomputedCount = 0;
+
+	if (!anyDirty)
+		return;
+
+	for (size_t i = 0; i < positions.size(); i++) {
+		uint32_t parentIndex = parents[i] != TransformId::INVALID_SLOT ? slots[parents[i]].index : TransformId::INVALID_SLOT;
+		bool parentChanged = parentIndex != TransformId::INVALID_SLOT && changed[parentIndex];
+
+		changed[i] = dirty[i] || parentChanged;
+		if (!changed[i])
+			continue;
+
+		Matrix local = Matrix::CreateScale(scales[i]) * Matrix::CreateFromQuaternion(rotations[i]) * Matrix::CreateTranslation(positions[i]);
+		worldMatrices[i] = parentIndex != TransformId::INVALID_SLOT ? local * worldMatrices[parentIndex] : local;
+
+		dirty[i] = 0;
+		recomputedCount++;
+	}
+
+	anyDirty = false;
+}
+
+/*
+* Copy world matrices into an array indexed by slot, so they can be read with a TransformId
+* without the slot table
+*/
+void TransformSystem::CopyWorldMatrices(std::vector<Matrix>& bySlot) const {
+	bySlot.resize(slots.size());
+
+	for (size_t i = 0; i < worldMatrices.size(); i++)
+		bySlot[owners[i]] = worldMatrices[i];
+}
+
+/*
+* Keep the matrices the last tick started from
+* Rendering blends them with the current ones, so motion is smooth when frames and ticks don't line up
+*/
+void TransformSystem::SavePreviousWorldMatrices() {
+	previousWorldMatrices.resize(slots.size());
+	previousGenerations.resize(slots.size(), TransformId::INVALID_SLOT); // Never saved
+
+	for (size_t i = 0; i < worldMatrices.size(); i++) {
+		uint32_t slot = owners[i];
+		previousWorldMatrices[slot] = worldMatrices[i];
+		previousGenerations[slot] = slots[slot].generation;
+	}
+}
+
+/*
+* Component-wise blend between the previous tick and the current state, "alpha" in [0; 1)
+* Exact for translation and scale, close enough for the small rotation of one tick
+* Transforms created after the last tick have no previous matrix and are not blended
+*/
+Matrix TransformSystem::GetInterpolatedWorldMatrix(TransformId transform, float alpha) const {
+	const Matrix& current = GetWorldMatrix(transform);
+	if (transform.slot >= previousWorldMatrices.size() || previousGenerations[transform.slot] != transform.generation)
+		return current;
+
+	return Matrix::Lerp(previousWorldMatrices[transform.slot], current, alpha);
+}
+
+void TransformSystem::CopyInterpolatedWorldMatrices(std::vector<Matrix>& bySlot, float alpha) const {
+	bySlot.resize(slots.size());
+
+	for (size_t i = 0; i < worldMatrices.size(); i++) {
+		uint32_t slot = owners[i];
+		if (slot < previousWorldMatrices.size() && previousGenerations[slot] == slots[slot].generation)
+			bySlot[slot] = Matrix::Lerp(previousWorldMatrices[slot], worldMatrices[i], alpha);
+		else
+			bySlot[slot] = worldMatrices[i];
+	}
+}
+
+size_t TransformSystem::GetCount() const {
+	return positions.size();
+}
+
+size_t TransformSystem::GetRecomputedCount() const {
+	return recomputedCount;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "SimpleMath.h"
+#include "SimpleMath.inl"
+
+/*
+* Handle of a transform
+* Generation changes when the slot is reused, so old handles become invalid
+*/
+struct TransformId {
+	uint32_t slot;
+	uint32_t generation;
+
+	static const uint32_t INVALID_SLOT = 0xFFFFFFFF;
+
+	TransformId() : slot(INVALID_SLOT), generation(0) {}
+	TransformId(uint32_t slot, uint32_t generation) : slot(slot), generation(generation) {}
+
+	bool IsValid() const { return slot != INVALID_SLOT; }
+	bool operator==(const TransformId& other) const { return slot == other.slot && generation == other.generation; }
+	bool operator!=(const TransformId& other) const { return !(*this == other); }
+};
+
+/*
+* Position / rotation / scale of all objects with parent-child links
+* Data is stored in SoA pools in depth-first order: a parent is always before its children
+* and a subtree is one continuous range, so world matrices are updated in one linear pass
+* World matrices are cached and recomputed only for dirty subtrees
+*/
+class TransformSystem {
+	struct Slot {
+		uint32_t index; // Position in pools
+		uint32_t generation;
+	};
+
+	// Pools (indexed by position in depth-first order)
+	std::vector<DirectX::SimpleMath::Vector3> positions;
+	std::vector<DirectX::SimpleMath::Quaternion> rotations;
+	std::vector<DirectX::SimpleMath::Vector3> scales;
+	std::vector<DirectX::SimpleMath::Matrix> worldMatrices;
+	std::vector<uint32_t> parents; // Slot of the parent or INVALID_SLOT
+	std::vector<uint32_t> subtreeSizes; // Number of transforms in subtree including itself
+	std::vector<uint8_t> dirty; // Local data changed since the last update
+	std::vector<uint8_t> changed; // World matrix changed during the last update
+	std::vector<uint32_t> owners; // Slot of every pool element
+
+	std::vector<Slot> slots;
+	std::vector<uint32_t> freeSlots;
+
+	// World matrices at the start of the last fixed tick (indexed by slot), for interpolation
+	std::vector<DirectX::SimpleMath::Matrix> previousWorldMatrices;
+	std::vector<uint32_t> previousGenerations; // Generation of the slot when it was saved
+
+	bool anyDirty;
+	size_t recomputedCount; // World matrices recomputed by the last update
+
+	uint32_t GetIndex(TransformId transform) const;
+	void Rotate(size_t first, size_t middle, size_t last);
+	void AddToAncestors(uint32_t parentSlot, int count);
+
+public:
+	TransformSystem();
+
+	TransformId Create(TransformId parent = TransformId());
+	void Destroy(TransformId transform); // Destroys the whole subtree
+	bool IsAlive(TransformId transform) const;
+
+	void SetParent(TransformId transform, TransformId parent);
+	TransformId GetParent(TransformId transform) const;
+
+	// Require IsAlive(transform), checked by an assert
+	void SetPosition(TransformId transform, const DirectX::SimpleMath::Vector3& position);
+	void SetRotation(TransformId transform, const DirectX::SimpleMath::Quaternion& rotation);
+	void SetScale(TransformId transform, const DirectX::SimpleMath::Vector3& scale);
+	void Translate(TransformId transform, const DirectX::SimpleMath::Vector3& offset);
+
+	DirectX::SimpleMath::Vector3 GetPosition(TransformId transform) const;
+	DirectX::SimpleMath::Quaternion GetRotation(TransformId transform) const;
+	DirectX::SimpleMath::Vector3 GetScale(TransformId transform) const;
+	const DirectX::SimpleMath::Matrix& GetWorldMatrix(TransformId transform) const; // As of the last UpdateWorldMatrices()
+
+	void UpdateWorldMatrices();
+	void CopyWorldMatrices(std::vector<DirectX::SimpleMath::Matrix>& bySlot) const; // For render snapshots
+
+	void SavePreviousWorldMatrices(); // Call before a fixed tick, after UpdateWorldMatrices()
+	DirectX::SimpleMath::Matrix GetInterpolatedWorldMatrix(TransformId transform, float alpha) const;
+	void CopyInterpolatedWorldMatrices(std::vector<DirectX::SimpleMath::Matrix>& bySlot, float alpha) const;
+
+	size_t GetCount() const;
+	size_t GetRecomputedCount() const;
+};
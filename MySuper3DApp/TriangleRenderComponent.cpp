@@ -4,7 +4,7 @@ TriangleRenderComponent::TriangleRenderComponent() : RenderComponent() {
 	indeces.insert(indeces.end(), { 0, 1, 2 });
 }
 
-TriangleRenderComponent::TriangleRenderComponent(std::shared_ptr<DirectX::SimpleMath::Vector4> renderOffset) :
-	RenderComponent(renderOffset) {
+TriangleRenderComponent::TriangleRenderComponent(TransformSystem* transforms, TransformId transform) :
+	RenderComponent(transforms, transform) {
 	indeces.insert(indeces.end(), { 0, 1, 2 });
 }
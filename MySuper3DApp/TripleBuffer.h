@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+
+/*
+* Lock-free handoff of the latest value from one writer thread to one reader thread
+* Writer fills GetBack() and calls Publish(), reader calls Acquire() and reads GetFront()
+* Neither side waits: an unread value is replaced by a newer one
+*/
+template<typename T>
+class TripleBuffer {
+	static const unsigned int NEW_BIT = 4; // Set in "ready" when it holds a value not acquired yet
+
+	T buffers[3];
+	std::atomic<unsigned int> ready; // Index of the last published buffer and NEW_BIT
+	unsigned int back; // Owned by the writer
+	unsigned int front; // Owned by the reader
+
+public:
+	TripleBuffer() : ready(1), back(0), front(2) {}
+
+	TripleBuffer(const TripleBuffer&) = delete;
+	TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+	T& GetBack() {
+		return buffers[back];
+	}
+
+	void Publish() {
+		back = ready.exchange(back | NEW_BIT, std::memory_order_acq_rel) & ~NEW_BIT;
+	}
+
+	bool HasNew() const {
+		return (ready.load(std::memory_order_acquire) & NEW_BIT) != 0;
+	}
+
+	// Returns false if nothing was published since the last call, front stays the same
+	bool Acquire() {
+		if (!HasNew())
+			return false;
+
+		front = ready.exchange(front, std::memory_order_acq_rel) & ~NEW_BIT;
+		return true;
+	}
+
+	const T& GetFront() const {
+		return buffers[front];
+	}
+};
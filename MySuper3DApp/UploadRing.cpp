@@ -0,0 +1,61 @@
+#include "UploadRing.h"
+
+const size_t UploadRing::ALIGNMENT;
+
+UploadRing::UploadRing(size_t capacity) {
+	this->capacity = capacity - capacity % ALIGNMENT;
+
+	data = nullptr;
+	used = 0;
+	open = false;
+	statistics = {};
+}
+
+void UploadRing::BeginFrame(void* data) {
+	this->data = static_cast<unsigned char*>(data);
+	used = 0;
+	open = true;
+}
+
+/*
+* Size is rounded up to ALIGNMENT, so every slice starts on a bindable offset
+*/
+UploadRing::Slice UploadRing::Allocate(size_t size) {
+	size_t alignedSize = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+	if (!open || !data || alignedSize > capacity - used) {
+		statistics.failedAllocations++;
+		return { nullptr, 0, 0 };
+	}
+
+	Slice slice = { data + used, used, alignedSize };
+	used += alignedSize;
+
+	return slice;
+}
+
+void UploadRing::EndFrame() {
+	if (!open)
+		return;
+
+	open = false;
+	data = nullptr;
+
+	statistics.lastFrameBytes = used;
+	if (used > statistics.peakFrameBytes)
+		statistics.peakFrameBytes = used;
+	statistics.totalBytes += used;
+	statistics.frames++;
+}
+
+size_t UploadRing::GetCapacity() const {
+	return capacity;
+}
+
+size_t UploadRing::GetUsed() const {
+	return used;
+}
+
+const UploadRing::Statistics& UploadRing::GetStatistics() const {
+	return statistics;
+}
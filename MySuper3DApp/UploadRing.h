@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*
+* Sub-allocator of one mapped upload buffer for a frame
+* Slices are bump-allocated with 256-byte alignment (constant buffer offset granularity),
+* the whole buffer is released by the next BeginFrame() when the buffer is discarded
+* Knows nothing about the graphics API: works on any memory, so it can be tested on the heap
+* Not thread-safe: used by the thread that records or replays draws
+*/
+class UploadRing {
+public:
+	static const size_t ALIGNMENT = 256;
+
+	struct Slice {
+		void* data; // Write the data here (nullptr if the ring is full)
+		size_t offset; // Bytes from the start of the buffer
+		size_t size; // Aligned size
+	};
+
+	struct Statistics {
+		size_t lastFrameBytes; // Bytes uploaded by the last finished frame
+		size_t peakFrameBytes;
+		unsigned long long totalBytes;
+		unsigned int frames;
+		unsigned int failedAllocations; // Slices that didn't fit since creation
+	};
+
+private:
+	unsigned char* data; // Mapped memory of the current frame
+	size_t capacity;
+	size_t used;
+	bool open; // Between BeginFrame() and EndFrame()
+	Statistics statistics;
+
+public:
+	UploadRing(size_t capacity);
+
+	void BeginFrame(void* data); // "data" - freshly mapped buffer of "capacity" bytes
+	Slice Allocate(size_t size);
+	void EndFrame(); // Before the buffer is unmapped
+
+	size_t GetCapacity() const;
+	size_t GetUsed() const; // Bytes of the current frame
+	const Statistics& GetStatistics() const;
+};
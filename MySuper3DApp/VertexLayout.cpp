@@ -0,0 +1,299 @@
+#include "VertexLayout.h"
+#include <cstring>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define VERTEX_PACKING_SSE2
+#endif
+#if defined(__F16C__) || defined(__AVX2__)
+#include <immintrin.h>
+#define VERTEX_PACKING_F16C
+#endif
+
+static const size_t SOURCE_STRIDE = 8; // Floats per source vertex
+static const size_t SOURCE_POSITION = 0;
+static const size_t SOURCE_COLOR = 4;
+
+VertexLayout::VertexLayout() {
+	stride = 0;
+}
+
+/*
+* Elements are packed one after another, every format is a multiple of 4 bytes
+*/
+VertexLayout& VertexLayout::Add(const char* semantic, VertexFormat format, uint32_t semanticIndex) {
+	elements.push_back({ semantic, semanticIndex, format, stride });
+	stride += GetFormatSize(format);
+	return *this;
+}
+
+const std::vector<VertexLayout::Element>& VertexLayout::GetElements() const {
+	return elements;
+}
+
+std::vector<VertexLayout::InputElement> VertexLayout::GetInputElements() const {
+	std::vector<InputElement> inputElements;
+	for (const Element& element : elements)
+		inputElements.push_back({ element.semantic, element.semanticIndex, GetDxgiFormat(element.format), element.offset });
+
+	return inputElements;
+}
+
+uint32_t VertexLayout::GetStride() const {
+	return stride;
+}
+
+uint32_t VertexLayout::GetFormatSize(VertexFormat format) {
+	switch (format) {
+	case VertexFormat::Float4: return 16;
+	case VertexFormat::Float3: return 12;
+	case VertexFormat::Float2: return 8;
+	case VertexFormat::Half4: return 8;
+	case VertexFormat::Half2: return 4;
+	case VertexFormat::UNorm8x4: return 4;
+	}
+	return 0;
+}
+
+uint32_t VertexLayout::GetComponentCount(VertexFormat format) {
+	switch (format) {
+	case VertexFormat::Float4: return 4;
+	case VertexFormat::Float3: return 3;
+	case VertexFormat::Float2: return 2;
+	case VertexFormat::Half4: return 4;
+	case VertexFormat::Half2: return 2;
+	case VertexFormat::UNorm8x4: return 4;
+	}
+	return 0;
+}
+
+uint32_t VertexLayout::GetDxgiFormat(VertexFormat format) {
+	switch (format) {
+	case VertexFormat::Float4: return 2; // DXGI_FORMAT_R32G32B32A32_FLOAT
+	case VertexFormat::Float3: return 6; // DXGI_FORMAT_R32G32B32_FLOAT
+	case VertexFormat::Float2: return 16; // DXGI_FORMAT_R32G32_FLOAT
+	case VertexFormat::Half4: return 10; // DXGI_FORMAT_R16G16B16A16_FLOAT
+	case VertexFormat::Half2: return 34; // DXGI_FORMAT_R16G16_FLOAT
+	case VertexFormat::UNorm8x4: return 28; // DXGI_FORMAT_R8G8B8A8_UNORM
+	}
+	return 0;
+}
+
+VertexLayout VertexLayout::Full() {
+	return VertexLayout().Add("POSITION", VertexFormat::Float4).Add("COLOR", VertexFormat::Float4);
+}
+
+VertexLayout VertexLayout::Compact() {
+	return VertexLayout().Add("POSITION", VertexFormat::Float3).Add("COLOR", VertexFormat::UNorm8x4);
+}
+
+VertexLayout VertexLayout::Flat() {
+	return VertexLayout().Add("POSITION", VertexFormat::Float2).Add("COLOR", VertexFormat::UNorm8x4);
+}
+
+VertexLayout VertexLayout::Tiny() {
+	return VertexLayout().Add("POSITION", VertexFormat::Half2).Add("COLOR", VertexFormat::UNorm8x4);
+}
+
+/*
+* One pass per element, so the format is chosen once and the inner loop is straight
+* Elements with unknown semantics are zeroed
+*/
+void VertexPacker::Pack(const VertexLayout& layout, const float* source, size_t count, void* destination) {
+	unsigned char* bytes = static_cast<unsigned char*>(destination);
+	size_t stride = layout.GetStride();
+
+	for (const VertexLayout::Element& element : layout.GetElements()) {
+		unsigned char* target = bytes + element.offset;
+		size_t components = VertexLayout::GetComponentCount(element.format);
+
+		const float* from = nullptr;
+		if (strcmp(element.semantic, "POSITION") == 0)
+			from = source + SOURCE_POSITION;
+		else if (strcmp(element.semantic, "COLOR") == 0)
+			from = source + SOURCE_COLOR;
+
+		if (!from) {
+			for (size_t i = 0; i < count; i++)
+				memset(target + i * stride, 0, VertexLayout::GetFormatSize(element.format));
+			continue;
+		}
+
+		switch (element.format) {
+		case VertexFormat::Float4:
+		case VertexFormat::Float3:
+		case VertexFormat::Float2:
+			PackFloat(from, SOURCE_STRIDE, components, count, target, stride);
+			break;
+		case VertexFormat::Half4:
+		case VertexFormat::Half2:
+			PackHalf(from, SOURCE_STRIDE, components, count, target, stride);
+			break;
+		case VertexFormat::UNorm8x4:
+			PackUNorm8x4(from, SOURCE_STRIDE, count, target, stride);
+			break;
+		}
+	}
+}
+
+/*
+* Clamp to [0; 1], scale to 255 and round
+* SSE2: one vertex per iteration, 4 floats -> 4 bytes with saturating packs
+*/
+void VertexPacker::PackUNorm8x4(const float* source, size_t sourceStride, size_t count, unsigned char* destination, size_t destinationStride) {
+#ifdef VERTEX_PACKING_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 scale = _mm_set1_ps(255.0f);
+
+	for (size_t i = 0; i < count; i++) {
+		__m128 value = _mm_loadu_ps(source + i * sourceStride);
+		value = _mm_min_ps(_mm_max_ps(value, zero), one);
+		__m128i integers = _mm_cvtps_epi32(_mm_mul_ps(value, scale));
+		__m128i packed = _mm_packus_epi16(_mm_packs_epi32(integers, integers), integers);
+
+		int32_t bytes = _mm_cvtsi128_si32(packed);
+		memcpy(destination + i * destinationStride, &bytes, sizeof(bytes));
+	}
+#else
+	for (size_t i = 0; i < count; i++) {
+		for (size_t c = 0; c < 4; c++) {
+			float value = source[i * sourceStride + c];
+			value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+			destination[i * destinationStride + c] = static_cast<unsigned char>(value * 255.0f + 0.5f);
+		}
+	}
+#endif
+}
+
+/*
+* F16C converts a whole vertex at once, otherwise bit manipulation per component
+*/
+void VertexPacker::PackHalf(const float* source, size_t sourceStride, size_t components, size_t count, unsigned char* destination, size_t destinationStride) {
+#ifdef VERTEX_PACKING_F16C
+	if (components == 4) {
+		for (size_t i = 0; i < count; i++) {
+			__m128i halves = _mm_cvtps_ph(_mm_loadu_ps(source + i * sourceStride), _MM_FROUND_TO_NEAREST_INT);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(destination + i * destinationStride), halves);
+		}
+		return;
+	}
+
+	if (components == 2) {
+		for (size_t i = 0; i < count; i++) {
+			__m128 value = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(source + i * sourceStride)));
+			int32_t halves = _mm_cvtsi128_si32(_mm_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT));
+			memcpy(destination + i * destinationStride, &halves, sizeof(halves));
+		}
+		return;
+	}
+#endif
+
+	for (size_t i = 0; i < count; i++) {
+		uint16_t halves[4];
+		for (size_t c = 0; c < components; c++)
+			halves[c] = FloatToHalf(source[i * sourceStride + c]);
+		memcpy(destination + i * destinationStride, halves, components * sizeof(uint16_t));
+	}
+}
+
+void VertexPacker::PackFloat(const float* source, size_t sourceStride, size_t components, size_t count, unsigned char* destination, size_t destinationStride) {
+	for (size_t i = 0; i < count; i++)
+		memcpy(destination + i * destinationStride, source + i * sourceStride, components * sizeof(float));
+}
+
+/*
+* Overflow gives infinity, small values become denormals or zero
+*/
+uint16_t VertexPacker::FloatToHalf(float value) {
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+	uint32_t mantissa = bits & 0x007FFFFF;
+	int exponent = static_cast<int>((bits >> 23) & 0xFF) - 127 + 15;
+
+	if ((bits & 0x7FFFFFFF) > 0x7F800000)
+		return sign | 0x7E00; // NaN
+	if (exponent >= 31)
+		return sign | 0x7C00; // Infinity
+
+	if (exponent <= 0) {
+		if (exponent < -10)
+			return sign;
+
+		mantissa |= 0x00800000;
+		int shift = 14 - exponent;
+		uint32_t half = mantissa >> shift;
+		uint32_t remainder = mantissa & ((1u << shift) - 1);
+		uint32_t halfway = 1u << (shift - 1);
+		if (remainder > halfway || (remainder == halfway && (half & 1)))
+			half++;
+		return sign | static_cast<uint16_t>(half);
+	}
+
+	// Rounding may carry into the exponent, up to infinity
+	uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+	uint32_t remainder = mantissa & 0x1FFF;
+	if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+		half++;
+	return sign | static_cast<uint16_t>(half);
+}
+
+float VertexPacker::HalfToFloat(uint16_t value) {
+	uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+	uint32_t exponent = (value >> 10) & 0x1F;
+	uint32_t mantissa = value & 0x3FF;
+	uint32_t bits;
+
+	if (exponent == 0) {
+		if (mantissa == 0)
+			bits = sign;
+		else {
+			// Denormal: normalize
+			exponent = 127 - 15 + 1;
+			while (!(mantissa & 0x400)) {
+				mantissa <<= 1;
+				exponent--;
+			}
+			bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+		}
+	}
+	else if (exponent == 31)
+		bits = sign | 0x7F800000 | (mantissa << 13);
+	else
+		bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+
+	float result;
+	memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+/*
+* Index 0xFFFF is still a valid vertex in triangle lists (strip cut only matters for strips)
+*/
+bool VertexPacker::CanUse16BitIndices(size_t vertexCount) {
+	return vertexCount <= 0x10000;
+}
+
+/*
+* SSE2 has only a signed 32 -> 16 saturating pack, so values are biased by 32768 before
+* packing and the sign bit is flipped back after
+*/
+void VertexPacker::PackIndices16(const int* source, size_t count, uint16_t* destination) {
+	size_t i = 0;
+
+#ifdef VERTEX_PACKING_SSE2
+	const __m128i bias = _mm_set1_epi32(0x8000);
+	const __m128i flip = _mm_set1_epi16(static_cast<short>(0x8000));
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i low = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)), bias);
+		__m128i high = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i + 4)), bias);
+		__m128i packed = _mm_xor_si128(_mm_packs_epi32(low, high), flip);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), packed);
+	}
+#endif
+
+	for (; i < count; i++)
+		destination[i] = static_cast<uint16_t>(source[i]);
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+* Format of one vertex attribute
+*/
+enum class VertexFormat {
+	Float4, // R32G32B32A32_FLOAT
+	Float3, // R32G32B32_FLOAT
+	Float2, // R32G32_FLOAT
+	Half4, // R16G16B16A16_FLOAT
+	Half2, // R16G16_FLOAT
+	UNorm8x4 // R8G8B8A8_UNORM, for colors
+};
+
+/*
+* Declarative description of an interleaved vertex
+* Generates the stride and the input elements (the same fields as D3D11_INPUT_ELEMENT_DESC),
+* so the layout and the vertex buffer can't disagree
+* Missing components are expanded by the input assembler: z = 0, w = 1,
+* so shaders keep "float4" inputs for every format
+*/
+class VertexLayout {
+public:
+	struct Element {
+		const char* semantic; // "POSITION" or "COLOR" can be packed from source vertices
+		uint32_t semanticIndex;
+		VertexFormat format;
+		uint32_t offset; // Bytes from the start of the vertex
+	};
+
+	struct InputElement {
+		const char* semantic;
+		uint32_t semanticIndex;
+		uint32_t dxgiFormat;
+		uint32_t offset;
+	};
+
+private:
+	std::vector<Element> elements;
+	uint32_t stride;
+
+public:
+	VertexLayout();
+
+	VertexLayout& Add(const char* semantic, VertexFormat format, uint32_t semanticIndex = 0);
+
+	const std::vector<Element>& GetElements() const;
+	std::vector<InputElement> GetInputElements() const;
+	uint32_t GetStride() const;
+
+	static uint32_t GetFormatSize(VertexFormat format);
+	static uint32_t GetComponentCount(VertexFormat format);
+	static uint32_t GetDxgiFormat(VertexFormat format);
+
+	static VertexLayout Full(); // float4 position, float4 color: 32 bytes
+	static VertexLayout Compact(); // float3 position, RGBA8 color: 16 bytes
+	static VertexLayout Flat(); // float2 position, RGBA8 color: 12 bytes (z = 0)
+	static VertexLayout Tiny(); // half2 position, RGBA8 color: 8 bytes (z = 0)
+};
+
+/*
+* Conversion of source vertices into a "VertexLayout"
+* Source vertices are "float4 position, float4 color" pairs, as in "RenderComponent::points"
+* SSE2 paths for colors and indices, F16C for halves when the compiler targets it
+*/
+class VertexPacker {
+public:
+	// "source" - 8 floats per vertex, "destination" - count * layout.GetStride() bytes
+	static void Pack(const VertexLayout& layout, const float* source, size_t count, void* destination);
+
+	static void PackUNorm8x4(const float* source, size_t sourceStride, size_t count, unsigned char* destination, size_t destinationStride);
+	static void PackHalf(const float* source, size_t sourceStride, size_t components, size_t count, unsigned char* destination, size_t destinationStride);
+	static void PackFloat(const float* source, size_t sourceStride, size_t components, size_t count, unsigned char* destination, size_t destinationStride);
+
+	static uint16_t FloatToHalf(float value); // Round to nearest even
+	static float HalfToFloat(uint16_t value);
+
+	static bool CanUse16BitIndices(size_t vertexCount);
+	static void PackIndices16(const int* source, size_t count, uint16_t* destination); // Indices must be in [0; 65535]
+};
@@ -0,0 +1,24 @@
+#pragma once
+#include <string>
+#include "Delegates.h"
+#include "InputRecording.h"
+
+/*
+* Interface of the window part of the platform layer
+* Owns the message pump and everything the user sees outside of the back buffer
+*/
+class WindowBackend {
+public:
+	// Raw keyboard and mouse input in the same form as it is recorded, called from ProcessMessages()
+	Delegate<void, const RecordedInputEvent&> InputReceived;
+
+	virtual ~WindowBackend() = default;
+
+	virtual bool ProcessMessages() = 0; // Handle pending messages, returns false when the application should quit
+	virtual void RequestExit() = 0;
+	virtual void SetTitle(const std::wstring& title) = 0;
+
+	virtual int GetClientWidth() = 0;
+	virtual int GetClientHeight() = 0;
+	virtual bool GetCursorPosition(int& x, int& y) = 0; // Client coordinates, false if there is no cursor
+};
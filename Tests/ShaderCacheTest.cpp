@@ -0,0 +1,131 @@
+#include "TestCheck.h"
+#include "ShaderCache.h"
+#include "StubShaderCompiler.h"
+#include <cstdio>
+#include <fstream>
+
+static std::string directory;
+
+static std::string WriteSource(const std::string& name, const std::string& text) {
+	std::string path = directory + "/" + name;
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file << text;
+	return path;
+}
+
+static ShaderDesc MakeDesc(const std::string& path, const std::string& entryPoint) {
+	ShaderDesc desc;
+	desc.path = path;
+	desc.entryPoint = entryPoint;
+	desc.profile = "vs_5_0";
+	desc.flags = 0;
+	return desc;
+}
+
+/*
+* Every field of the description and the source change the key
+*/
+static void TestKeys() {
+	ShaderDesc desc = MakeDesc("a.hlsl", "VSMain");
+	uint64_t key = ShaderCache::ComputeKey("source", desc);
+
+	CHECK(ShaderCache::ComputeKey("source", desc) == key);
+	CHECK(ShaderCache::ComputeKey("source2", desc) != key);
+
+	ShaderDesc other = desc;
+	other.profile = "ps_5_0";
+	CHECK(ShaderCache::ComputeKey("source", other) != key);
+
+	other = desc;
+	other.flags = 1;
+	CHECK(ShaderCache::ComputeKey("source", other) != key);
+
+	other = desc;
+	other.defines.push_back({ "COMPACT", "1" });
+	CHECK(ShaderCache::ComputeKey("source", other) != key);
+
+	// Fields are separated, moving a character between them is another key
+	ShaderDesc left = desc;
+	left.defines.push_back({ "AB", "C" });
+	ShaderDesc right = desc;
+	right.defines.push_back({ "A", "BC" });
+	CHECK(ShaderCache::ComputeKey("source", left) != ShaderCache::ComputeKey("source", right));
+}
+
+/*
+* Compiled once, then served from memory, then from disk by a new cache
+*/
+static void TestHits() {
+	std::string source = "float4 VSMain() : SV_POSITION { return 0; }";
+	std::string path = WriteSource("hits.hlsl", source);
+	ShaderDesc desc = MakeDesc(path, "VSMain");
+	std::string errors;
+
+	// Blob of an earlier run
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.cso", static_cast<unsigned long long>(ShaderCache::ComputeKey(source, desc)));
+	std::remove((directory + "/" + name).c_str());
+
+	auto compiler = std::make_shared<StubShaderCompiler>();
+	ShaderCache cache(compiler, directory);
+
+	uint64_t key = 0;
+	auto first = cache.GetBytecode(desc, errors, &key);
+	auto second = cache.GetBytecode(desc, errors);
+
+	CHECK(first && !first->empty());
+	CHECK(first == second);
+	CHECK(compiler->GetCompileCount() == 1);
+	CHECK(cache.GetStatistics().compiles == 1);
+	CHECK(cache.GetStatistics().memoryHits == 1);
+
+	auto diskCompiler = std::make_shared<StubShaderCompiler>();
+	ShaderCache diskCache(diskCompiler, directory);
+
+	uint64_t diskKey = 0;
+	auto loaded = diskCache.GetBytecode(desc, errors, &diskKey);
+
+	CHECK(loaded && first && *loaded == *first);
+	CHECK(diskKey == key);
+	CHECK(diskCompiler->GetCompileCount() == 0);
+	CHECK(diskCache.GetStatistics().diskHits == 1);
+}
+
+/*
+* Errors are reported and not cached, a fixed source compiles after Clear()
+*/
+static void TestFailures() {
+	std::string errors;
+	auto compiler = std::make_shared<StubShaderCompiler>();
+	ShaderCache cache(compiler, "");
+
+	CHECK(!cache.GetBytecode(MakeDesc(directory + "/missing.hlsl", "VSMain"), errors));
+	CHECK(errors.find("Missing shader file") != std::string::npos);
+
+	std::string path = WriteSource("broken.hlsl", "float4 Main() : SV_POSITION { return 0; }");
+	ShaderDesc desc = MakeDesc(path, "VSMain");
+
+	errors.clear();
+	CHECK(!cache.GetBytecode(desc, errors));
+	CHECK(!errors.empty());
+	CHECK(!cache.GetBytecode(desc, errors));
+	CHECK(compiler->GetCompileCount() == 2);
+	CHECK(cache.GetStatistics().failures == 3);
+
+	WriteSource("broken.hlsl", "float4 VSMain() : SV_POSITION { return 0; }");
+	cache.Clear();
+
+	CHECK(cache.GetBytecode(desc, errors) != nullptr);
+	CHECK(compiler->GetCompileCount() == 3);
+}
+
+int main(int argc, char* argv[]) {
+	// Directory for sources and blobs, made by the build
+	directory = argc > 1 ? argv[1] : ".";
+
+	TestKeys();
+	TestHits();
+	TestFailures();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,149 @@
+#include "TestCheck.h"
+#include "SoftwareRasterizer.h"
+#include "JobSystem.h"
+#include <cstdlib>
+#include <fstream>
+
+// Several tiles in both directions, the last ones partial
+static const int WIDTH = 160;
+static const int HEIGHT = 96;
+
+static const float CLEAR_COLOR[4] = { 0.18f, 0.55f, 0.34f, 1.0f };
+
+/*
+* Overlapping triangles of both windings, 32 and 16-bit indices, a world matrix
+* and a triangle that leaves the screen
+*/
+static void DrawScene(SoftwareRasterizer& rasterizer) {
+	static const SoftwareVertex vertices[] = {
+		{ { -0.9f, -0.8f, 0.5f, 1.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } },
+		{ { 0.3f, 0.9f, 0.5f, 1.0f }, { 0.0f, 1.0f, 0.0f, 1.0f } },
+		{ { 0.6f, -0.6f, 0.5f, 1.0f }, { 0.0f, 0.0f, 1.0f, 1.0f } },
+		{ { -0.2f, 0.2f, 0.5f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f } },
+		{ { 1.5f, 0.4f, 0.5f, 1.0f }, { 1.0f, 1.0f, 0.0f, 1.0f } },
+		{ { 0.4f, -1.4f, 0.5f, 1.0f }, { 0.0f, 1.0f, 1.0f, 1.0f } },
+	};
+	static const uint32_t indices[] = { 0, 1, 2, 3, 4, 5 };
+	static const uint16_t indices16[] = { 0, 2, 1 };
+
+	// Half size, moved to the upper left
+	static const float world[16] = {
+		0.5f, 0.0f, 0.0f, 0.0f,
+		0.0f, 0.5f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		-0.4f, 0.4f, 0.0f, 1.0f,
+	};
+
+	rasterizer.BeginFrame(CLEAR_COLOR);
+	rasterizer.DrawIndexed(vertices, 6, indices, 6, 0, nullptr);
+	rasterizer.DrawIndexed16(vertices, 6, indices16, 3, 0, world);
+	rasterizer.EndFrame();
+}
+
+static bool ReadPPM(const std::string& path, int& width, int& height, std::vector<unsigned char>& rgb) {
+	std::ifstream file(path, std::ios::binary);
+	std::string magic;
+	int maxValue = 0;
+	if (!(file >> magic >> width >> height >> maxValue) || magic != "P6" || maxValue != 255)
+		return false;
+	file.get();
+
+	rgb.resize(static_cast<size_t>(width) * height * 3);
+	file.read(reinterpret_cast<char*>(rgb.data()), rgb.size());
+	return static_cast<bool>(file);
+}
+
+/*
+* The frame matches the checked in image, channels may differ by one for other compilers and SIMD paths
+*/
+static void TestGoldenImage(const std::string& goldenPath, const std::string& outputPath) {
+	SoftwareRasterizer rasterizer(WIDTH, HEIGHT, nullptr);
+	DrawScene(rasterizer);
+	CHECK(rasterizer.WritePPM(outputPath));
+
+	int width = 0, height = 0;
+	std::vector<unsigned char> golden;
+	CHECK(ReadPPM(goldenPath, width, height, golden));
+	CHECK(width == WIDTH && height == HEIGHT);
+
+	int outputWidth = 0, outputHeight = 0;
+	std::vector<unsigned char> output;
+	CHECK(ReadPPM(outputPath, outputWidth, outputHeight, output));
+
+	size_t differences = 0;
+	if (golden.size() == output.size()) {
+		for (size_t i = 0; i < golden.size(); i++) {
+			if (std::abs(golden[i] - output[i]) > 1)
+				differences++;
+		}
+	}
+	else
+		differences = output.size();
+
+	if (differences > 0)
+		std::cout << "Golden image mismatch: " << differences << " channels, frame written to " << outputPath << std::endl;
+	CHECK(differences == 0);
+}
+
+/*
+* Binning and parallel tiles don't change a pixel
+*/
+static void TestThreadedMatchesSingleThread() {
+	SoftwareRasterizer single(WIDTH, HEIGHT, nullptr);
+	DrawScene(single);
+
+	JobSystem jobSystem(4);
+	SoftwareRasterizer threaded(WIDTH, HEIGHT, &jobSystem);
+	DrawScene(threaded);
+
+	CHECK(single.GetFramebuffer() == threaded.GetFramebuffer());
+	CHECK(single.GetStatistics().pixels == threaded.GetStatistics().pixels);
+}
+
+/*
+* Two triangles of a pixel aligned quad share the diagonal, the top-left rule writes every pixel once
+*/
+static void TestSharedEdge() {
+	SoftwareRasterizer rasterizer(WIDTH, HEIGHT, nullptr);
+
+	// 32 x 32 pixels from (64; 32), across a tile border
+	float left = 64.0f / WIDTH * 2 - 1, right = 96.0f / WIDTH * 2 - 1;
+	float top = 1 - 32.0f / HEIGHT * 2, bottom = 1 - 64.0f / HEIGHT * 2;
+	SoftwareVertex vertices[] = {
+		{ { left, top, 0.5f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f } },
+		{ { right, top, 0.5f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f } },
+		{ { right, bottom, 0.5f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f } },
+		{ { left, bottom, 0.5f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f } },
+	};
+	uint32_t indices[] = { 0, 1, 2, 0, 2, 3 };
+
+	rasterizer.BeginFrame(CLEAR_COLOR);
+	rasterizer.DrawIndexed(vertices, 4, indices, 6, 0, nullptr);
+	rasterizer.EndFrame();
+
+	CHECK(rasterizer.GetStatistics().triangles == 2);
+	CHECK(rasterizer.GetStatistics().pixels == 32 * 32);
+}
+
+/*
+* Arguments: golden image, path for the rendered frame
+* "--update" as the third argument rewrites the golden image after an intended change
+*/
+int main(int argc, char* argv[]) {
+	if (argc < 3) {
+		std::cout << "Usage: SoftwareRasterizerTest <golden image> <output image> [--update]" << std::endl;
+		return 1;
+	}
+
+	if (argc > 3 && std::string(argv[3]) == "--update") {
+		SoftwareRasterizer rasterizer(WIDTH, HEIGHT, nullptr);
+		DrawScene(rasterizer);
+		return rasterizer.WritePPM(argv[1]) ? 0 : 1;
+	}
+
+	TestGoldenImage(argv[1], argv[2]);
+	TestThreadedMatchesSingleThread();
+	TestSharedEdge();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <iostream>
+
+/*
+* Minimal checks for the test executables run by CTest
+* A failed check prints its place and makes the executable return 1
+*/
+static int testFailures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::cout << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" << std::endl; \
+			testFailures++; \
+		} \
+	} while (0)
+
+#define TEST_RESULT() (testFailures == 0 ? 0 : 1)
@@ -0,0 +1,100 @@
+#include "TestCheck.h"
+#include "UploadRing.h"
+#include <vector>
+
+/*
+* Every slice starts on ALIGNMENT and takes a multiple of it, the capacity is rounded down
+*/
+static void TestAlignment() {
+	UploadRing ring(4 * UploadRing::ALIGNMENT + 100);
+	CHECK(ring.GetCapacity() == 4 * UploadRing::ALIGNMENT);
+
+	std::vector<unsigned char> buffer(ring.GetCapacity());
+	ring.BeginFrame(buffer.data());
+
+	size_t sizes[] = { 1, 64, UploadRing::ALIGNMENT, UploadRing::ALIGNMENT + 1 };
+	size_t expectedOffsets[] = { 0, 1, 2 };
+	for (int i = 0; i < 3; i++) {
+		UploadRing::Slice slice = ring.Allocate(sizes[i]);
+		CHECK(slice.data == buffer.data() + slice.offset);
+		CHECK(slice.offset == expectedOffsets[i] * UploadRing::ALIGNMENT);
+		CHECK(slice.offset % UploadRing::ALIGNMENT == 0);
+		CHECK(slice.size == UploadRing::ALIGNMENT);
+	}
+	CHECK(ring.GetUsed() == 3 * UploadRing::ALIGNMENT);
+
+	// Two aligned blocks, only one is left
+	UploadRing::Slice slice = ring.Allocate(sizes[3]);
+	CHECK(slice.data == nullptr);
+
+	ring.EndFrame();
+}
+
+/*
+* A full ring refuses slices instead of wrapping over data of the frame, which the GPU may still read
+*/
+static void TestFullRingRefuses() {
+	UploadRing ring(2 * UploadRing::ALIGNMENT);
+	std::vector<unsigned char> buffer(ring.GetCapacity(), 0);
+	ring.BeginFrame(buffer.data());
+
+	UploadRing::Slice first = ring.Allocate(16);
+	UploadRing::Slice second = ring.Allocate(16);
+	CHECK(first.data && second.data);
+	static_cast<unsigned char*>(first.data)[0] = 1;
+	static_cast<unsigned char*>(second.data)[0] = 2;
+
+	UploadRing::Slice third = ring.Allocate(16);
+	CHECK(third.data == nullptr);
+	CHECK(third.size == 0);
+	CHECK(ring.GetUsed() == ring.GetCapacity());
+	CHECK(buffer[0] == 1 && buffer[UploadRing::ALIGNMENT] == 2);
+
+	ring.EndFrame();
+	CHECK(ring.GetStatistics().failedAllocations == 1);
+
+	// Outside of a frame there is no mapped memory
+	CHECK(ring.Allocate(16).data == nullptr);
+	CHECK(ring.GetStatistics().failedAllocations == 2);
+}
+
+/*
+* The next frame starts from the beginning of its freshly mapped buffer
+*/
+static void TestWrapAround() {
+	UploadRing ring(3 * UploadRing::ALIGNMENT);
+	std::vector<unsigned char> frames[2] = {
+		std::vector<unsigned char>(ring.GetCapacity()),
+		std::vector<unsigned char>(ring.GetCapacity()),
+	};
+
+	for (int frame = 0; frame < 4; frame++) {
+		std::vector<unsigned char>& buffer = frames[frame % 2];
+		ring.BeginFrame(buffer.data());
+
+		UploadRing::Slice first = ring.Allocate(100);
+		CHECK(first.data == buffer.data());
+		CHECK(first.offset == 0);
+
+		// Frames use a different amount, the last one fills the ring
+		for (int i = 0; i < frame && i < 2; i++)
+			CHECK(ring.Allocate(100).data != nullptr);
+
+		ring.EndFrame();
+	}
+
+	const UploadRing::Statistics& statistics = ring.GetStatistics();
+	CHECK(statistics.frames == 4);
+	CHECK(statistics.lastFrameBytes == 3 * UploadRing::ALIGNMENT);
+	CHECK(statistics.peakFrameBytes == 3 * UploadRing::ALIGNMENT);
+	CHECK(statistics.totalBytes == (1 + 2 + 3 + 3) * UploadRing::ALIGNMENT);
+	CHECK(statistics.failedAllocations == 0);
+}
+
+int main() {
+	TestAlignment();
+	TestFullRingRefuses();
+	TestWrapAround();
+
+	return TEST_RESULT();
+}